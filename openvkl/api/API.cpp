@@ -1,6 +1,7 @@
 // Copyright 2019-2020 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include "../common/Future.h"
 #include "../common/logging.h"
 #include "../common/simd.h"
 #include "Driver.h"
@@ -84,6 +85,19 @@ extern "C" VKLData vklNewData(size_t numItems,
 }
 OPENVKL_CATCH_END(nullptr)
 
+extern "C" VKLData vklNewDataFromFile(const char *filename,
+                                      size_t offset,
+                                      size_t numItems,
+                                      VKLDataType dataType) OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  THROW_IF_NULL_STRING(filename);
+  VKLData data = openvkl::api::currentDriver().newDataFromFile(
+      filename, offset, numItems, dataType);
+  return data;
+}
+OPENVKL_CATCH_END(nullptr)
+
 ///////////////////////////////////////////////////////////////////////////////
 // Observer ///////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -275,6 +289,28 @@ extern "C" void vklRelease(VKLObject object) OPENVKL_CATCH_BEGIN
 }
 OPENVKL_CATCH_END()
 
+extern "C" VKLFuture vklCommitAsync(VKLObject object) OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  THROW_IF_NULL_OBJECT(object);
+  return openvkl::api::currentDriver().commitAsync(object);
+}
+OPENVKL_CATCH_END(nullptr)
+
+extern "C" int vklIsReady(VKLFuture future) OPENVKL_CATCH_BEGIN
+{
+  THROW_IF_NULL_OBJECT(future);
+  return ((openvkl::Future *)future)->isReady();
+}
+OPENVKL_CATCH_END(0)
+
+extern "C" void vklWait(VKLFuture future) OPENVKL_CATCH_BEGIN
+{
+  THROW_IF_NULL_OBJECT(future);
+  ((openvkl::Future *)future)->wait();
+}
+OPENVKL_CATCH_END()
+
 extern "C" void vklShutdown() OPENVKL_CATCH_BEGIN
 {
   openvkl::api::Driver::current.reset();
@@ -517,6 +553,17 @@ extern "C" void vklSetInt(VKLObject object,
 }
 OPENVKL_CATCH_END()
 
+extern "C" void vklSetSize(VKLObject object,
+                           const char *name,
+                           size_t x) OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  THROW_IF_NULL_OBJECT(object);
+  THROW_IF_NULL_STRING(name);
+  openvkl::api::currentDriver().setSize(object, name, x);
+}
+OPENVKL_CATCH_END()
+
 extern "C" void vklSetVec3i(
     VKLObject object, const char *name, int x, int y, int z) OPENVKL_CATCH_BEGIN
 {
@@ -656,6 +703,49 @@ __define_vklComputeSampleN(16);
 
 #undef __define_vklComputeSampleN
 
+extern "C" void vklComputeSampleN(VKLVolume volume,
+                                  unsigned int N,
+                                  const vkl_vec3f *objectCoordinates,
+                                  float *samples) OPENVKL_CATCH_BEGIN
+{
+  if (N == 0)
+    return;
+
+  THROW_IF_NULL(objectCoordinates, "objectCoordinates");
+  THROW_IF_NULL(samples, "samples");
+
+  openvkl::api::currentDriver().computeSampleN(
+      volume,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(objectCoordinates),
+      samples);
+}
+OPENVKL_CATCH_END()
+
+extern "C" void vklComputeSampleNSOA(VKLVolume volume,
+                                     unsigned int N,
+                                     const float *objectCoordinatesX,
+                                     const float *objectCoordinatesY,
+                                     const float *objectCoordinatesZ,
+                                     float *samples) OPENVKL_CATCH_BEGIN
+{
+  if (N == 0)
+    return;
+
+  THROW_IF_NULL(objectCoordinatesX, "objectCoordinatesX");
+  THROW_IF_NULL(objectCoordinatesY, "objectCoordinatesY");
+  THROW_IF_NULL(objectCoordinatesZ, "objectCoordinatesZ");
+  THROW_IF_NULL(samples, "samples");
+
+  openvkl::api::currentDriver().computeSampleNSOA(volume,
+                                                  N,
+                                                  objectCoordinatesX,
+                                                  objectCoordinatesY,
+                                                  objectCoordinatesZ,
+                                                  samples);
+}
+OPENVKL_CATCH_END()
+
 extern "C" vkl_vec3f vklComputeGradient(
     VKLVolume volume, const vkl_vec3f *objectCoordinates) OPENVKL_CATCH_BEGIN
 {
@@ -691,6 +781,148 @@ __define_vklComputeGradientN(16);
 
 #undef __define_vklComputeGradientN
 
+extern "C" void vklComputeSampleAndGradientN(VKLVolume volume,
+                                             unsigned int N,
+                                             const vkl_vec3f *objectCoordinates,
+                                             float *samples,
+                                             vkl_vec3f *gradients)
+    OPENVKL_CATCH_BEGIN
+{
+  if (N == 0)
+    return;
+
+  THROW_IF_NULL(objectCoordinates, "objectCoordinates");
+  THROW_IF_NULL(samples, "samples");
+  THROW_IF_NULL(gradients, "gradients");
+
+  openvkl::api::currentDriver().computeSampleAndGradientN(
+      volume,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(objectCoordinates),
+      samples,
+      reinterpret_cast<vvec3fn<1> *>(gradients));
+}
+OPENVKL_CATCH_END()
+
+extern "C" unsigned int vklGetNumAttributes(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN
+{
+  THROW_IF_NULL_OBJECT(volume);
+  return openvkl::api::currentDriver().getNumAttributes(volume);
+}
+OPENVKL_CATCH_END(0)
+
+extern "C" void vklComputeSampleM(VKLVolume volume,
+                                  const vkl_vec3f *objectCoordinates,
+                                  float *samples,
+                                  unsigned int M,
+                                  const unsigned int *attributeIndices)
+    OPENVKL_CATCH_BEGIN
+{
+  if (M == 0)
+    return;
+
+  THROW_IF_NULL(objectCoordinates, "objectCoordinates");
+  THROW_IF_NULL(samples, "samples");
+  THROW_IF_NULL(attributeIndices, "attributeIndices");
+
+  openvkl::api::currentDriver().computeSampleM(
+      volume,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      samples,
+      M,
+      attributeIndices);
+}
+OPENVKL_CATCH_END()
+
+extern "C" void vklComputeSampleMN(VKLVolume volume,
+                                   unsigned int N,
+                                   const vkl_vec3f *objectCoordinates,
+                                   float *samples,
+                                   unsigned int M,
+                                   const unsigned int *attributeIndices)
+    OPENVKL_CATCH_BEGIN
+{
+  if (N == 0 || M == 0)
+    return;
+
+  THROW_IF_NULL(objectCoordinates, "objectCoordinates");
+  THROW_IF_NULL(samples, "samples");
+  THROW_IF_NULL(attributeIndices, "attributeIndices");
+
+  openvkl::api::currentDriver().computeSampleMN(
+      volume,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(objectCoordinates),
+      samples,
+      M,
+      attributeIndices);
+}
+OPENVKL_CATCH_END()
+
+extern "C" float vklComputeSampleAtTime(VKLVolume volume,
+                                        const vkl_vec3f *objectCoordinates,
+                                        float time) OPENVKL_CATCH_BEGIN
+{
+  THROW_IF_NULL(objectCoordinates, "objectCoordinates");
+
+  float sample;
+  openvkl::api::currentDriver().computeSampleAtTime(
+      volume,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      time,
+      &sample);
+  return sample;
+}
+OPENVKL_CATCH_END(ospcommon::math::nan)
+
+extern "C" void vklComputeSampleAtTimeN(VKLVolume volume,
+                                        unsigned int N,
+                                        const vkl_vec3f *objectCoordinates,
+                                        const float *times,
+                                        float *samples) OPENVKL_CATCH_BEGIN
+{
+  if (N == 0)
+    return;
+
+  THROW_IF_NULL(objectCoordinates, "objectCoordinates");
+  THROW_IF_NULL(times, "times");
+  THROW_IF_NULL(samples, "samples");
+
+  openvkl::api::currentDriver().computeSampleAtTimeN(
+      volume,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(objectCoordinates),
+      times,
+      samples);
+}
+OPENVKL_CATCH_END()
+
+extern "C" void vklInitAccessor(VKLAccessor *accessor,
+                                VKLVolume volume) OPENVKL_CATCH_BEGIN
+{
+  THROW_IF_NULL(accessor, "accessor");
+
+  openvkl::api::currentDriver().initAccessor(*accessor, volume);
+}
+OPENVKL_CATCH_END()
+
+extern "C" float vklComputeSampleWithAccessor(
+    VKLAccessor *accessor,
+    const vkl_vec3f *objectCoordinates) OPENVKL_CATCH_BEGIN
+{
+  THROW_IF_NULL(accessor, "accessor");
+  THROW_IF_NULL(objectCoordinates, "objectCoordinates");
+
+  float sample;
+  openvkl::api::currentDriver().computeSampleWithAccessor(
+      *accessor,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      &sample);
+  return sample;
+}
+OPENVKL_CATCH_END(ospcommon::math::nan)
+
 extern "C" vkl_box3f vklGetBoundingBox(VKLVolume volume) OPENVKL_CATCH_BEGIN
 {
   const box3f result = openvkl::api::currentDriver().getBoundingBox(volume);
@@ -704,3 +936,15 @@ extern "C" vkl_range1f vklGetValueRange(VKLVolume volume) OPENVKL_CATCH_BEGIN
   return reinterpret_cast<const vkl_range1f &>(result);
 }
 OPENVKL_CATCH_END(vkl_range1f{ospcommon::math::nan})
+
+extern "C" void vklVolumeInvalidateRegion(VKLVolume volume,
+                                          const vkl_box3i *region)
+    OPENVKL_CATCH_BEGIN
+{
+  THROW_IF_NULL_OBJECT(volume);
+  THROW_IF_NULL(region, "region");
+
+  openvkl::api::currentDriver().invalidateRegion(
+      volume, reinterpret_cast<const box3i &>(*region));
+}
+OPENVKL_CATCH_END()
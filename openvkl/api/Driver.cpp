@@ -3,9 +3,13 @@
 
 #include "Driver.h"
 #include <sstream>
+#include "../common/Future.h"
+#include "../common/Numa.h"
+#include "../common/logging.h"
 #include "../common/objectFactory.h"
 #include "ispc_util_ispc.h"
 #include "ospcommon/tasking/tasking_system_init.h"
+#include "ospcommon/utility/OnScopeExit.h"
 #include "ospcommon/utility/StringManip.h"
 #include "ospcommon/utility/getEnvVar.h"
 
@@ -154,6 +158,19 @@ namespace openvkl {
       bool flushDenormals =
           OPENVKL_FLUSH_DENORMALS.value_or(getParam<int>("flushDenormals", 1));
 
+      // pinning of tasking threads to logical CPUs, in NUMA node order
+      auto OPENVKL_SET_AFFINITY =
+          utility::getEnvVar<int>("OPENVKL_SET_AFFINITY");
+      bool setAffinity =
+          OPENVKL_SET_AFFINITY.value_or(getParam<int>("setAffinity", 0));
+
+      // threads start on demand, so affinities are set up first
+      if (!setTaskingThreadAffinity(setAffinity)) {
+        postLogMessage(VKL_LOG_WARNING)
+            << "setAffinity is not supported by the tasking system; threads "
+               "are not pinned";
+      }
+
       tasking::initTaskingSystem(numThreads, flushDenormals);
 
       committed = true;
@@ -164,6 +181,21 @@ namespace openvkl {
       return committed;
     }
 
+    VKLFuture Driver::commitAsync(VKLObject object)
+    {
+      ManagedObject *managedObject = (ManagedObject *)object;
+      managedObject->refInc();
+
+      Future *future = new Future([this, managedObject]() {
+        utility::OnScopeExit releaseObject(
+            [managedObject]() { managedObject->refDec(); });
+
+        commit((VKLObject)managedObject);
+      });
+
+      return (VKLFuture)future;
+    }
+
     bool driverIsSet()
     {
       return Driver::current.get() != nullptr;
@@ -47,6 +47,10 @@ namespace openvkl {
       virtual void commit(VKLObject object)  = 0;
       virtual void release(VKLObject object) = 0;
 
+      // runs commit(object) on the tasking system; the object is kept alive
+      // until the commit has completed
+      virtual VKLFuture commitAsync(VKLObject object);
+
       /////////////////////////////////////////////////////////////////////////
       // Driver parameters (updated on commit()) //////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -66,6 +70,11 @@ namespace openvkl {
                               const void *source,
                               VKLDataCreationFlags dataCreationFlags) = 0;
 
+      virtual VKLData newDataFromFile(const char *filename,
+                                      size_t offset,
+                                      size_t numItems,
+                                      VKLDataType dataType) = 0;
+
       /////////////////////////////////////////////////////////////////////////
       // Observer /////////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -208,6 +217,9 @@ namespace openvkl {
                            const bool b)                                    = 0;
       virtual void set1f(VKLObject object, const char *name, const float x) = 0;
       virtual void set1i(VKLObject object, const char *name, const int x)   = 0;
+      virtual void setSize(VKLObject object,
+                           const char *name,
+                           const size_t x)                                  = 0;
       virtual void setVec3f(VKLObject object,
                             const char *name,
                             const vec3f &v)                                 = 0;
@@ -255,6 +267,18 @@ namespace openvkl {
 
 #undef __define_computeSampleN
 
+      virtual void computeSampleN(VKLVolume volume,
+                                  unsigned int N,
+                                  const vvec3fn<1> *objectCoordinates,
+                                  float *samples) = 0;
+
+      virtual void computeSampleNSOA(VKLVolume volume,
+                                     unsigned int N,
+                                     const float *objectCoordinatesX,
+                                     const float *objectCoordinatesY,
+                                     const float *objectCoordinatesZ,
+                                     float *samples) = 0;
+
 #define __define_computeGradientN(WIDTH)                                       \
   virtual void computeGradient##WIDTH(const int *valid,                        \
                                       VKLVolume volume,                        \
@@ -268,10 +292,53 @@ namespace openvkl {
 
 #undef __define_computeGradientN
 
+      virtual void computeSampleAndGradientN(
+          VKLVolume volume,
+          unsigned int N,
+          const vvec3fn<1> *objectCoordinates,
+          float *samples,
+          vvec3fn<1> *gradients) = 0;
+
+      virtual unsigned int getNumAttributes(VKLVolume volume) = 0;
+
+      virtual void computeSampleM(VKLVolume volume,
+                                  const vvec3fn<1> &objectCoordinates,
+                                  float *samples,
+                                  unsigned int M,
+                                  const unsigned int *attributeIndices) = 0;
+
+      virtual void computeSampleMN(VKLVolume volume,
+                                   unsigned int N,
+                                   const vvec3fn<1> *objectCoordinates,
+                                   float *samples,
+                                   unsigned int M,
+                                   const unsigned int *attributeIndices) = 0;
+
+      virtual void computeSampleAtTime(VKLVolume volume,
+                                       const vvec3fn<1> &objectCoordinates,
+                                       float time,
+                                       float *sample) = 0;
+
+      virtual void computeSampleAtTimeN(VKLVolume volume,
+                                        unsigned int N,
+                                        const vvec3fn<1> *objectCoordinates,
+                                        const float *times,
+                                        float *samples) = 0;
+
+      virtual void initAccessor(VKLAccessor &accessor, VKLVolume volume) = 0;
+
+      virtual void computeSampleWithAccessor(
+          VKLAccessor &accessor,
+          const vvec3fn<1> &objectCoordinates,
+          float *sample) = 0;
+
       virtual box3f getBoundingBox(VKLVolume volume) = 0;
 
       virtual range1f getValueRange(VKLVolume volume) = 0;
 
+      virtual void invalidateRegion(VKLVolume volume,
+                                    const box3i &region) = 0;
+
      private:
       bool committed = false;
     };
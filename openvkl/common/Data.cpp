@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Data.h"
+#include "Numa.h"
 #include "ospcommon/memory/malloc.h"
 
 namespace openvkl {
@@ -20,7 +21,9 @@ namespace openvkl {
         throw std::runtime_error("shared buffer is NULL");
       data = source;
     } else {
-      void *buffer = ospcommon::memory::alignedMalloc(numBytes + 16);
+      void *buffer = (dataCreationFlags & VKL_DATA_NUMA_INTERLEAVED)
+                         ? numaAlloc(numBytes + 16, numaInterleaved)
+                         : ospcommon::memory::alignedMalloc(numBytes + 16);
       if (buffer == nullptr)
         throw std::runtime_error("data is NULL");
       data = buffer;
@@ -40,6 +43,19 @@ namespace openvkl {
     }
   }
 
+  Data::Data(size_t numItems, VKLDataType dataType)
+      : numItems(numItems),
+        numBytes(numItems * sizeOf(dataType)),
+        dataType(dataType),
+        data(nullptr),
+        dataCreationFlags(VKL_DATA_SHARED_BUFFER)
+  {
+    if (isManagedObject(dataType))
+      throw std::runtime_error("data of object handles must be copied");
+
+    managedObjectType = VKL_DATA;
+  }
+
   Data::~Data()
   {
     if (isManagedObject(dataType)) {
@@ -53,7 +69,10 @@ namespace openvkl {
     if (!(dataCreationFlags & VKL_DATA_SHARED_BUFFER)) {
       // We know we allocated this buffer, so the const cast is in fact
       // reasonable.
-      ospcommon::memory::alignedFree(const_cast<void *>(data));
+      if (dataCreationFlags & VKL_DATA_NUMA_INTERLEAVED)
+        numaFree(const_cast<void *>(data), numBytes + 16);
+      else
+        ospcommon::memory::alignedFree(const_cast<void *>(data));
     }
   }
 
@@ -35,6 +35,11 @@ namespace openvkl {
     VKLDataType dataType;
     const void *data;
     VKLDataCreationFlags dataCreationFlags;
+
+   protected:
+    // for derived types which provide (and own) the buffer themselves; data
+    // must be set by the derived constructor
+    Data(size_t numItems, VKLDataType dataType);
   };
 
   template <typename T>
@@ -0,0 +1,54 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Future.h"
+
+namespace openvkl {
+
+  Future::Future(const std::function<void()> &operation)
+      : task([operation]() -> std::exception_ptr {
+          // exceptions cannot be reported from the task, as it does not run
+          // on an application thread
+          try {
+            operation();
+          } catch (...) {
+            return std::current_exception();
+          }
+
+          return std::exception_ptr();
+        })
+  {
+  }
+
+  Future::~Future()
+  {
+    try {
+      wait();
+    } catch (const std::exception &e) {
+      handleError(VKL_UNKNOWN_ERROR, e.what());
+    } catch (...) {
+      handleError(VKL_UNKNOWN_ERROR, "an unrecognized exception was caught");
+    }
+  }
+
+  std::string Future::toString() const
+  {
+    return "openvkl::Future";
+  }
+
+  bool Future::isReady() const
+  {
+    return task.finished();
+  }
+
+  void Future::wait()
+  {
+    const std::exception_ptr exception = task.get();
+
+    if (exception && !errorReported) {
+      errorReported = true;
+      std::rethrow_exception(exception);
+    }
+  }
+
+}  // namespace openvkl
@@ -0,0 +1,38 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <exception>
+#include <functional>
+#include "ManagedObject.h"
+#include "openvkl/openvkl.h"
+#include "ospcommon/tasking/AsyncTask.h"
+
+namespace openvkl {
+
+  // an operation run asynchronously on the tasking system
+  struct OPENVKL_CORE_INTERFACE Future : public ManagedObject
+  {
+    explicit Future(const std::function<void()> &operation);
+
+    // waits for completion; errors not reported by wait() are reported
+    // through the error handler
+    virtual ~Future() override;
+
+    virtual std::string toString() const override;
+
+    bool isReady() const;
+
+    // waits for completion, and rethrows any exception thrown by the
+    // operation on the first call
+    void wait();
+
+   private:
+    // holds the exception thrown by the operation, if any
+    ospcommon::tasking::AsyncTask<std::exception_ptr> task;
+
+    bool errorReported{false};
+  };
+
+}  // namespace openvkl
@@ -0,0 +1,146 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MappedFileData.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openvkl {
+
+#ifdef _WIN32
+
+  MappedFileData::MappedFileData(const std::string &filename,
+                                 size_t offset,
+                                 size_t numItems,
+                                 VKLDataType dataType)
+      : Data(numItems, dataType)
+  {
+    if (numBytes == 0)
+      throw std::runtime_error("mapped file data must not be empty");
+
+    HANDLE file = CreateFileA(filename.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_FLAG_RANDOM_ACCESS,
+                              nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+      throw std::runtime_error("could not open file " + filename);
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) ||
+        offset + numBytes > size_t(fileSize.QuadPart)) {
+      CloseHandle(file);
+      throw std::runtime_error("file " + filename +
+                               " is too small for the requested data");
+    }
+
+    // the mapping is kept alive by the view; the file handle is not needed
+    // afterwards
+    fileMapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (!fileMapping)
+      throw std::runtime_error("could not map file " + filename);
+
+    // views must start at a multiple of the allocation granularity
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+
+    const size_t mappingOffset =
+        offset - offset % systemInfo.dwAllocationGranularity;
+
+    mappingSize = offset - mappingOffset + numBytes;
+
+    mapping = MapViewOfFile(fileMapping,
+                            FILE_MAP_READ,
+                            DWORD(uint64_t(mappingOffset) >> 32),
+                            DWORD(mappingOffset & 0xffffffff),
+                            mappingSize);
+
+    if (!mapping) {
+      CloseHandle(fileMapping);
+      throw std::runtime_error("could not map file " + filename);
+    }
+
+    data = static_cast<const char *>(mapping) + (offset - mappingOffset);
+  }
+
+  MappedFileData::~MappedFileData()
+  {
+    UnmapViewOfFile(mapping);
+    CloseHandle(fileMapping);
+  }
+
+#else
+
+  MappedFileData::MappedFileData(const std::string &filename,
+                                 size_t offset,
+                                 size_t numItems,
+                                 VKLDataType dataType)
+      : Data(numItems, dataType)
+  {
+    if (numBytes == 0)
+      throw std::runtime_error("mapped file data must not be empty");
+
+    const int fd = open(filename.c_str(), O_RDONLY);
+
+    if (fd == -1)
+      throw std::runtime_error("could not open file " + filename);
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == -1 ||
+        offset + numBytes > size_t(fileStat.st_size)) {
+      close(fd);
+      throw std::runtime_error("file " + filename +
+                               " is too small for the requested data");
+    }
+
+    // mappings must start at a page boundary
+    const size_t pageSize      = size_t(sysconf(_SC_PAGESIZE));
+    const size_t mappingOffset = offset - offset % pageSize;
+
+    mappingSize = offset - mappingOffset + numBytes;
+
+    mapping =
+        mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, mappingOffset);
+
+    // the mapping stays valid after closing the file
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+      mapping = nullptr;
+      throw std::runtime_error("could not map file " + filename);
+    }
+
+    // volumes are sampled and processed brick-wise rather than in file
+    // order, so read-ahead would mostly load pages which are not used soon
+    madvise(mapping, mappingSize, MADV_RANDOM);
+
+    data = static_cast<const char *>(mapping) + (offset - mappingOffset);
+  }
+
+  MappedFileData::~MappedFileData()
+  {
+    munmap(mapping, mappingSize);
+  }
+
+#endif
+
+  std::string MappedFileData::toString() const
+  {
+    return "openvkl::MappedFileData";
+  }
+
+}  // namespace openvkl
@@ -0,0 +1,35 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Data.h"
+
+namespace openvkl {
+
+  // data backed by a read-only memory mapping of a file. pages are loaded on
+  // demand by the operating system when first accessed, so that creating the
+  // data object does not read the file.
+  struct OPENVKL_CORE_INTERFACE MappedFileData : public Data
+  {
+    MappedFileData(const std::string &filename,
+                   size_t offset,
+                   size_t numItems,
+                   VKLDataType dataType);
+
+    virtual ~MappedFileData() override;
+
+    virtual std::string toString() const override;
+
+   private:
+    // start and size of the mapping, which begins at a page boundary and may
+    // therefore precede data
+    void *mapping{nullptr};
+    size_t mappingSize{0};
+
+#ifdef _WIN32
+    void *fileMapping{nullptr};
+#endif
+  };
+
+}  // namespace openvkl
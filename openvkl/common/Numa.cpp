@@ -0,0 +1,409 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Numa.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+#ifdef OSPCOMMON_TASKING_TBB
+#include <tbb/task_scheduler_observer.h>
+#endif
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#else
+#include "ospcommon/memory/malloc.h"
+#endif
+
+namespace openvkl {
+
+  namespace {
+
+    // logical CPUs of each node, and the node of each logical CPU
+    struct NumaTopology
+    {
+      std::vector<std::vector<int>> nodeCpus;
+      std::vector<int> cpuNodes;
+
+      // node numbers of the operating system, per node
+      std::vector<int> osNodes;
+
+      NumaTopology();
+
+      static const NumaTopology &get()
+      {
+        static const NumaTopology topology;
+        return topology;
+      }
+
+     private:
+      void addNode(int osNode, const std::vector<int> &cpus)
+      {
+        for (int cpu : cpus) {
+          if (cpu >= int(cpuNodes.size())) {
+            cpuNodes.resize(cpu + 1, 0);
+          }
+          cpuNodes[cpu] = int(nodeCpus.size());
+        }
+
+        nodeCpus.push_back(cpus);
+        osNodes.push_back(osNode);
+      }
+
+      // fallback if the topology cannot be determined
+      void setSingleNode()
+      {
+        const int numCpus =
+            std::max(int(std::thread::hardware_concurrency()), 1);
+
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < numCpus; cpu++) {
+          cpus.push_back(cpu);
+        }
+
+        addNode(0, cpus);
+      }
+    };
+
+#if defined(__linux__)
+
+    // parses CPU lists of the form "0-3,8,10-11"
+    std::vector<int> parseCpuList(const std::string &cpuList)
+    {
+      std::vector<int> cpus;
+
+      std::stringstream stream(cpuList);
+      std::string range;
+
+      while (std::getline(stream, range, ',')) {
+        if (range.empty() || !std::isdigit(range[0])) {
+          continue;
+        }
+
+        const size_t dash = range.find('-');
+        const int first   = std::atoi(range.c_str());
+        const int last    = dash == std::string::npos
+                             ? first
+                             : std::atoi(range.c_str() + dash + 1);
+
+        for (int cpu = first; cpu <= last; cpu++) {
+          cpus.push_back(cpu);
+        }
+      }
+
+      return cpus;
+    }
+
+    NumaTopology::NumaTopology()
+    {
+      const std::string nodesPath = "/sys/devices/system/node";
+
+      std::vector<int> allOsNodes;
+
+      if (DIR *dir = opendir(nodesPath.c_str())) {
+        while (dirent *entry = readdir(dir)) {
+          const std::string name = entry->d_name;
+
+          if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+              std::isdigit(name[4])) {
+            allOsNodes.push_back(std::atoi(name.c_str() + 4));
+          }
+        }
+
+        closedir(dir);
+      }
+
+      std::sort(allOsNodes.begin(), allOsNodes.end());
+
+      for (int osNode : allOsNodes) {
+        std::ifstream file(nodesPath + "/node" + std::to_string(osNode) +
+                           "/cpulist");
+        std::string cpuList;
+        std::getline(file, cpuList);
+
+        const std::vector<int> cpus = parseCpuList(cpuList);
+
+        // memory-only nodes are not considered
+        if (!cpus.empty()) {
+          addNode(osNode, cpus);
+        }
+      }
+
+      if (nodeCpus.empty()) {
+        setSingleNode();
+      }
+    }
+
+#elif defined(_WIN32)
+
+    NumaTopology::NumaTopology()
+    {
+      ULONG highestNode = 0;
+      GetNumaHighestNodeNumber(&highestNode);
+
+      for (ULONG node = 0; node <= highestNode; node++) {
+        GROUP_AFFINITY affinity;
+        if (!GetNumaNodeProcessorMaskEx(USHORT(node), &affinity)) {
+          continue;
+        }
+
+        std::vector<int> cpus;
+
+        for (int bit = 0; bit < 64; bit++) {
+          if (affinity.Mask & (KAFFINITY(1) << bit)) {
+            cpus.push_back(affinity.Group * 64 + bit);
+          }
+        }
+
+        if (!cpus.empty()) {
+          addNode(int(node), cpus);
+        }
+      }
+
+      if (nodeCpus.empty()) {
+        setSingleNode();
+      }
+    }
+
+#else
+
+    NumaTopology::NumaTopology()
+    {
+      setSingleNode();
+    }
+
+#endif
+
+#ifdef OSPCOMMON_TASKING_TBB
+
+    struct ThreadPinningObserver : public tbb::task_scheduler_observer
+    {
+      ThreadPinningObserver() : cpus(getNumaOrderedCpus())
+      {
+        observe(true);
+      }
+
+      ~ThreadPinningObserver()
+      {
+        observe(false);
+      }
+
+      void on_scheduler_entry(bool isWorker) override
+      {
+        if (isWorker) {
+          pinCurrentThread(cpus[nextCpu++ % cpus.size()]);
+        }
+      }
+
+     private:
+      std::vector<int> cpus;
+      std::atomic<size_t> nextCpu{1};
+    };
+
+#endif
+
+  }  // namespace
+
+  int getNumNumaNodes()
+  {
+    return int(NumaTopology::get().nodeCpus.size());
+  }
+
+  int getCurrentNumaNode()
+  {
+    const NumaTopology &topology = NumaTopology::get();
+
+    if (topology.nodeCpus.size() == 1) {
+      return 0;
+    }
+
+#if defined(_WIN32)
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    const int cpu = processor.Group * 64 + processor.Number;
+#elif defined(__linux__)
+    const int cpu = sched_getcpu();
+#else
+    const int cpu = 0;
+#endif
+
+    if (cpu < 0 || cpu >= int(topology.cpuNodes.size())) {
+      return 0;
+    }
+
+    return topology.cpuNodes[cpu];
+  }
+
+  std::vector<int> getNumaOrderedCpus()
+  {
+    std::vector<int> cpus;
+
+    for (const std::vector<int> &nodeCpus : NumaTopology::get().nodeCpus) {
+      cpus.insert(cpus.end(), nodeCpus.begin(), nodeCpus.end());
+    }
+
+    return cpus;
+  }
+
+  bool pinCurrentThread(int cpu)
+  {
+#if defined(_WIN32)
+    GROUP_AFFINITY affinity = {};
+    affinity.Group          = WORD(cpu / 64);
+    affinity.Mask           = KAFFINITY(1) << (cpu % 64);
+
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr);
+#elif defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) ==
+           0;
+#else
+    return false;
+#endif
+  }
+
+  bool setTaskingThreadAffinity(bool enabled)
+  {
+#ifdef OSPCOMMON_TASKING_TBB
+    static std::unique_ptr<ThreadPinningObserver> observer;
+
+    if (enabled && !observer) {
+      observer.reset(new ThreadPinningObserver);
+    } else if (!enabled) {
+      observer.reset();
+    }
+
+    return true;
+#else
+    return !enabled;
+#endif
+  }
+
+#if defined(_WIN32)
+
+  void *numaAlloc(size_t numBytes, int node)
+  {
+    // Windows has no interleaving policy; such pages are placed on first
+    // touch
+    if (node == numaInterleaved || getNumNumaNodes() == 1) {
+      return VirtualAlloc(
+          nullptr, numBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+
+    return VirtualAllocExNuma(GetCurrentProcess(),
+                              nullptr,
+                              numBytes,
+                              MEM_RESERVE | MEM_COMMIT,
+                              PAGE_READWRITE,
+                              DWORD(NumaTopology::get().osNodes[node]));
+  }
+
+  void numaFree(void *ptr, size_t)
+  {
+    if (ptr) {
+      VirtualFree(ptr, 0, MEM_RELEASE);
+    }
+  }
+
+#elif defined(__linux__)
+
+  // memory policies of the mbind() system call, see <numaif.h>; the system
+  // call is used directly to avoid a dependency on libnuma
+  static constexpr int mpolPreferred  = 1;
+  static constexpr int mpolInterleave = 3;
+
+  void *numaAlloc(size_t numBytes, int node)
+  {
+    if (numBytes == 0) {
+      return nullptr;
+    }
+
+    void *ptr = mmap(nullptr,
+                     numBytes,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS,
+                     -1,
+                     0);
+
+    if (ptr == MAP_FAILED) {
+      return nullptr;
+    }
+
+    const NumaTopology &topology = NumaTopology::get();
+
+    if (topology.nodeCpus.size() > 1) {
+      const int maxOsNode      = topology.osNodes.back();
+      const size_t bitsPerWord = 8 * sizeof(unsigned long);
+
+      std::vector<unsigned long> nodeMask(maxOsNode / bitsPerWord + 1, 0);
+
+      auto setNodeBit = [&](int osNode) {
+        nodeMask[osNode / bitsPerWord] |= 1ul << (osNode % bitsPerWord);
+      };
+
+      if (node == numaInterleaved) {
+        for (int osNode : topology.osNodes) {
+          setNodeBit(osNode);
+        }
+      } else {
+        setNodeBit(topology.osNodes[node]);
+      }
+
+      // the policy applies to pages faulted in afterwards, regardless of the
+      // thread touching them; failures leave the default policy in place
+      syscall(SYS_mbind,
+              ptr,
+              numBytes,
+              node == numaInterleaved ? mpolInterleave : mpolPreferred,
+              nodeMask.data(),
+              nodeMask.size() * bitsPerWord + 1,
+              0);
+    }
+
+    return ptr;
+  }
+
+  void numaFree(void *ptr, size_t numBytes)
+  {
+    if (ptr) {
+      munmap(ptr, numBytes);
+    }
+  }
+
+#else
+
+  void *numaAlloc(size_t numBytes, int)
+  {
+    return ospcommon::memory::alignedMalloc(numBytes, 4096);
+  }
+
+  void numaFree(void *ptr, size_t)
+  {
+    ospcommon::memory::alignedFree(ptr);
+  }
+
+#endif
+
+}  // namespace openvkl
@@ -0,0 +1,46 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "VKLCommon.h"
+
+namespace openvkl {
+
+  // NUMA nodes are identified by an index in [0, getNumNumaNodes()), which
+  // need not match the node numbering of the operating system. on systems
+  // without NUMA support, or where the topology cannot be determined, a single
+  // node is reported.
+
+  OPENVKL_CORE_INTERFACE int getNumNumaNodes();
+
+  // node of the logical CPU the calling thread is currently running on
+  OPENVKL_CORE_INTERFACE int getCurrentNumaNode();
+
+  // logical CPUs of the system, grouped by node in increasing node order
+  OPENVKL_CORE_INTERFACE std::vector<int> getNumaOrderedCpus();
+
+  // pins the calling thread to the given logical CPU. returns false if
+  // affinities are not supported or the CPU is not available.
+  OPENVKL_CORE_INTERFACE bool pinCurrentThread(int cpu);
+
+  // if enabled, pins worker threads of the tasking system to logical CPUs in
+  // node order as they start; the first CPU is left to the application thread.
+  // already pinned threads are not unpinned when disabled. returns false if
+  // the tasking system does not support pinning.
+  OPENVKL_CORE_INTERFACE bool setTaskingThreadAffinity(bool enabled);
+
+  // node value for numaAlloc() which interleaves pages over all nodes
+  constexpr int numaInterleaved = -1;
+
+  // allocates page-aligned memory whose pages are placed on the given node, or
+  // interleaved over all nodes. placement is best effort: if it cannot be
+  // applied, pages are placed by the operating system's default policy.
+  // returns nullptr on failure; memory must be released with numaFree().
+  OPENVKL_CORE_INTERFACE void *numaAlloc(size_t numBytes, int node);
+
+  OPENVKL_CORE_INTERFACE void numaFree(void *ptr, size_t numBytes);
+
+}  // namespace openvkl
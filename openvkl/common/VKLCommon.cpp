@@ -118,6 +118,8 @@ namespace openvkl {
       return sizeof(vec3ul);
     case VKL_VEC4UL:
       return sizeof(vec4ul);
+    case VKL_HALF:
+      return sizeof(uint16);
     case VKL_FLOAT:
       return sizeof(float);
     case VKL_VEC2F:
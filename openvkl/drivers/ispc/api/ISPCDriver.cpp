@@ -3,11 +3,13 @@
 
 #include "ISPCDriver.h"
 #include "../common/Data.h"
+#include "../common/MappedFileData.h"
 #include "../common/Observer.h"
 #include "../common/export_util.h"
 #include "../value_selector/ValueSelector.h"
 #include "../volume/Volume.h"
 #include "ISPCDriver_ispc.h"
+#include "ospcommon/tasking/parallel_for.h"
 
 namespace openvkl {
   namespace ispc_driver {
@@ -58,6 +60,16 @@ namespace openvkl {
       return (VKLData)data;
     }
 
+    template <int W>
+    VKLData ISPCDriver<W>::newDataFromFile(const char *filename,
+                                           size_t offset,
+                                           size_t numItems,
+                                           VKLDataType dataType)
+    {
+      Data *data = new MappedFileData(filename, offset, numItems, dataType);
+      return (VKLData)data;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Observer ///////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -280,6 +292,15 @@ namespace openvkl {
       managedObject->setParam(name, x);
     }
 
+    template <int W>
+    void ISPCDriver<W>::setSize(VKLObject object,
+                                const char *name,
+                                const size_t x)
+    {
+      ManagedObject *managedObject = (ManagedObject *)object;
+      managedObject->setParam(name, x);
+    }
+
     template <int W>
     void ISPCDriver<W>::setVec3f(VKLObject object,
                                  const char *name,
@@ -407,6 +428,41 @@ namespace openvkl {
       *sample = sampleW[0];
     }
 
+    template <int W>
+    void ISPCDriver<W>::computeSampleN(VKLVolume volume,
+                                       unsigned int N,
+                                       const vvec3fn<1> *objectCoordinates,
+                                       float *samples)
+    {
+      // vvec3fn<1> is layout compatible with vkl_vec3f, i.e. an array of
+      // structures with a stride of 3 floats
+      static_assert(sizeof(vvec3fn<1>) == 3 * sizeof(float),
+                    "vvec3fn<1> must be tightly packed");
+
+      const float *x = &objectCoordinates[0].x[0];
+      const float *y = &objectCoordinates[0].y[0];
+      const float *z = &objectCoordinates[0].z[0];
+
+      computeSampleNAnyLayout(volume, N, x, y, z, 3, samples);
+    }
+
+    template <int W>
+    void ISPCDriver<W>::computeSampleNSOA(VKLVolume volume,
+                                          unsigned int N,
+                                          const float *objectCoordinatesX,
+                                          const float *objectCoordinatesY,
+                                          const float *objectCoordinatesZ,
+                                          float *samples)
+    {
+      computeSampleNAnyLayout(volume,
+                              N,
+                              objectCoordinatesX,
+                              objectCoordinatesY,
+                              objectCoordinatesZ,
+                              1,
+                              samples);
+    }
+
 #define __define_computeGradientN(WIDTH)              \
   template <int W>                                    \
   void ISPCDriver<W>::computeGradient##WIDTH(         \
@@ -426,6 +482,162 @@ namespace openvkl {
 
 #undef __define_computeGradientN
 
+    template <int W>
+    void ISPCDriver<W>::computeSampleAndGradientN(
+        VKLVolume volume,
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients)
+    {
+      const auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      const unsigned int numChunks =
+          N / computeSampleNChunkSize + (N % computeSampleNChunkSize != 0);
+
+      if (numChunks <= 1) {
+        volumeObject.computeSampleAndGradientN(
+            N, objectCoordinates, samples, gradients);
+        return;
+      }
+
+      tasking::parallel_for(numChunks, [&](unsigned int chunkIndex) {
+        const size_t begin = size_t(chunkIndex) * computeSampleNChunkSize;
+        const size_t end =
+            std::min(size_t(N), begin + computeSampleNChunkSize);
+
+        volumeObject.computeSampleAndGradientN(end - begin,
+                                               objectCoordinates + begin,
+                                               samples + begin,
+                                               gradients + begin);
+      });
+    }
+
+    template <int W>
+    unsigned int ISPCDriver<W>::getNumAttributes(VKLVolume volume)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      return volumeObject.getNumAttributes();
+    }
+
+    template <int W>
+    void ISPCDriver<W>::computeSampleM(VKLVolume volume,
+                                       const vvec3fn<1> &objectCoordinates,
+                                       float *samples,
+                                       unsigned int M,
+                                       const unsigned int *attributeIndices)
+    {
+      const auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      checkAttributeIndices(volumeObject, M, attributeIndices);
+
+      volumeObject.computeSampleM(
+          objectCoordinates, samples, M, attributeIndices);
+    }
+
+    template <int W>
+    void ISPCDriver<W>::computeSampleMN(VKLVolume volume,
+                                        unsigned int N,
+                                        const vvec3fn<1> *objectCoordinates,
+                                        float *samples,
+                                        unsigned int M,
+                                        const unsigned int *attributeIndices)
+    {
+      const auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      checkAttributeIndices(volumeObject, M, attributeIndices);
+
+      const unsigned int numChunks =
+          N / computeSampleNChunkSize + (N % computeSampleNChunkSize != 0);
+
+      if (numChunks <= 1) {
+        volumeObject.computeSampleMN(
+            N, objectCoordinates, M, attributeIndices, N, samples);
+        return;
+      }
+
+      // samples of each attribute are contiguous, so chunks write to M
+      // separate ranges of the output
+      tasking::parallel_for(numChunks, [&](unsigned int chunkIndex) {
+        const size_t begin = size_t(chunkIndex) * computeSampleNChunkSize;
+        const size_t end =
+            std::min(size_t(N), begin + computeSampleNChunkSize);
+
+        volumeObject.computeSampleMN(end - begin,
+                                     objectCoordinates + begin,
+                                     M,
+                                     attributeIndices,
+                                     N,
+                                     samples + begin);
+      });
+    }
+
+    template <int W>
+    void ISPCDriver<W>::computeSampleAtTime(VKLVolume volume,
+                                            const vvec3fn<1> &objectCoordinates,
+                                            float time,
+                                            float *sample)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      vfloatn<1> sampleW;
+      volumeObject.computeSampleAtTime(objectCoordinates, time, sampleW);
+      *sample = sampleW[0];
+    }
+
+    template <int W>
+    void ISPCDriver<W>::computeSampleAtTimeN(
+        VKLVolume volume,
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        const float *times,
+        float *samples)
+    {
+      const auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      const unsigned int numChunks =
+          N / computeSampleNChunkSize + (N % computeSampleNChunkSize != 0);
+
+      if (numChunks <= 1) {
+        volumeObject.computeSampleAtTimeN(N, objectCoordinates, times, samples);
+        return;
+      }
+
+      tasking::parallel_for(numChunks, [&](unsigned int chunkIndex) {
+        const size_t begin = size_t(chunkIndex) * computeSampleNChunkSize;
+        const size_t end =
+            std::min(size_t(N), begin + computeSampleNChunkSize);
+
+        volumeObject.computeSampleAtTimeN(end - begin,
+                                          objectCoordinates + begin,
+                                          times + begin,
+                                          samples + begin);
+      });
+    }
+
+    template <int W>
+    void ISPCDriver<W>::initAccessor(VKLAccessor &accessor, VKLVolume volume)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      accessor.volume = (VKLVolume)&volumeObject;
+
+      volumeObject.initAccessor(accessor);
+    }
+
+    template <int W>
+    void ISPCDriver<W>::computeSampleWithAccessor(
+        VKLAccessor &accessor,
+        const vvec3fn<1> &objectCoordinates,
+        float *sample)
+    {
+      const auto &volumeObject =
+          referenceFromHandle<Volume<W>>(accessor.volume);
+      vfloatn<1> sampleW;
+      volumeObject.computeSampleWithAccessor(
+          accessor, objectCoordinates, sampleW);
+      *sample = sampleW[0];
+    }
+
     template <int W>
     box3f ISPCDriver<W>::getBoundingBox(VKLVolume volume)
     {
@@ -440,6 +652,13 @@ namespace openvkl {
       return volumeObject.getValueRange();
     }
 
+    template <int W>
+    void ISPCDriver<W>::invalidateRegion(VKLVolume volume, const box3i &region)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      volumeObject.invalidateRegion(region);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Private methods ////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -682,6 +901,67 @@ namespace openvkl {
       }
     }
 
+    template <int W>
+    void ISPCDriver<W>::computeSampleNAnyLayout(
+        VKLVolume volume,
+        unsigned int N,
+        const float *objectCoordinatesX,
+        const float *objectCoordinatesY,
+        const float *objectCoordinatesZ,
+        unsigned int stride,
+        float *samples)
+    {
+      const auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      const unsigned int numChunks =
+          N / computeSampleNChunkSize + (N % computeSampleNChunkSize != 0);
+
+      // avoid tasking overhead for short streams
+      if (numChunks <= 1) {
+        volumeObject.computeSampleN(N,
+                                    objectCoordinatesX,
+                                    objectCoordinatesY,
+                                    objectCoordinatesZ,
+                                    stride,
+                                    samples);
+        return;
+      }
+
+      tasking::parallel_for(numChunks, [&](unsigned int chunkIndex) {
+        const size_t begin = size_t(chunkIndex) * computeSampleNChunkSize;
+        const size_t end =
+            std::min(size_t(N), begin + computeSampleNChunkSize);
+
+        const size_t ofs = begin * stride;
+
+        volumeObject.computeSampleN(end - begin,
+                                    objectCoordinatesX + ofs,
+                                    objectCoordinatesY + ofs,
+                                    objectCoordinatesZ + ofs,
+                                    stride,
+                                    samples + begin);
+      });
+    }
+
+    template <int W>
+    void ISPCDriver<W>::checkAttributeIndices(
+        const Volume<W> &volume,
+        unsigned int M,
+        const unsigned int *attributeIndices)
+    {
+      const unsigned int numAttributes = volume.getNumAttributes();
+
+      for (unsigned int i = 0; i < M; i++) {
+        if (attributeIndices[i] >= numAttributes) {
+          throw std::runtime_error("invalid attribute index " +
+                                   std::to_string(attributeIndices[i]) +
+                                   " for volume with " +
+                                   std::to_string(numAttributes) +
+                                   " attributes");
+        }
+      }
+    }
+
     template <int W>
     template <int OW>
     typename std::enable_if<(OW < W), void>::type
@@ -33,6 +33,11 @@ namespace openvkl {
                       const void *source,
                       VKLDataCreationFlags dataCreationFlags) override;
 
+      VKLData newDataFromFile(const char *filename,
+                              size_t offset,
+                              size_t numItems,
+                              VKLDataType dataType) override;
+
       /////////////////////////////////////////////////////////////////////////
       // Observer /////////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -140,6 +145,9 @@ namespace openvkl {
       void setBool(VKLObject object, const char *name, const bool b) override;
       void set1f(VKLObject object, const char *name, const float x) override;
       void set1i(VKLObject object, const char *name, const int x) override;
+      void setSize(VKLObject object,
+                   const char *name,
+                   const size_t x) override;
       void setVec3f(VKLObject object,
                     const char *name,
                     const vec3f &v) override;
@@ -187,6 +195,18 @@ namespace openvkl {
 
 #undef __define_computeSampleN
 
+      void computeSampleN(VKLVolume volume,
+                          unsigned int N,
+                          const vvec3fn<1> *objectCoordinates,
+                          float *samples) override;
+
+      void computeSampleNSOA(VKLVolume volume,
+                             unsigned int N,
+                             const float *objectCoordinatesX,
+                             const float *objectCoordinatesY,
+                             const float *objectCoordinatesZ,
+                             float *samples) override;
+
 #define __define_computeGradientN(WIDTH)                               \
   void computeGradient##WIDTH(const int *valid,                        \
                               VKLVolume volume,                        \
@@ -200,10 +220,50 @@ namespace openvkl {
 
 #undef __define_computeGradientN
 
+      void computeSampleAndGradientN(VKLVolume volume,
+                                     unsigned int N,
+                                     const vvec3fn<1> *objectCoordinates,
+                                     float *samples,
+                                     vvec3fn<1> *gradients) override;
+
+      unsigned int getNumAttributes(VKLVolume volume) override;
+
+      void computeSampleM(VKLVolume volume,
+                          const vvec3fn<1> &objectCoordinates,
+                          float *samples,
+                          unsigned int M,
+                          const unsigned int *attributeIndices) override;
+
+      void computeSampleMN(VKLVolume volume,
+                           unsigned int N,
+                           const vvec3fn<1> *objectCoordinates,
+                           float *samples,
+                           unsigned int M,
+                           const unsigned int *attributeIndices) override;
+
+      void computeSampleAtTime(VKLVolume volume,
+                               const vvec3fn<1> &objectCoordinates,
+                               float time,
+                               float *sample) override;
+
+      void computeSampleAtTimeN(VKLVolume volume,
+                                unsigned int N,
+                                const vvec3fn<1> *objectCoordinates,
+                                const float *times,
+                                float *samples) override;
+
+      void initAccessor(VKLAccessor &accessor, VKLVolume volume) override;
+
+      void computeSampleWithAccessor(VKLAccessor &accessor,
+                                     const vvec3fn<1> &objectCoordinates,
+                                     float *sample) override;
+
       box3f getBoundingBox(VKLVolume volume) override;
 
       range1f getValueRange(VKLVolume volume) override;
 
+      void invalidateRegion(VKLVolume volume, const box3i &region) override;
+
      private:
       template <int OW>
       typename std::enable_if<(OW == W), void>::type
@@ -294,6 +354,26 @@ namespace openvkl {
           const vvec3fn<OW> &objectCoordinates,
           float *samples);
 
+      // streams are split into chunks of this many coordinates, which are
+      // sampled in parallel
+      static constexpr unsigned int computeSampleNChunkSize = 4096;
+
+      // coordinates are given as separate x, y, z arrays with the given stride
+      // (in floats) between consecutive elements, covering both AOS and SOA
+      // inputs
+      void computeSampleNAnyLayout(VKLVolume volume,
+                                   unsigned int N,
+                                   const float *objectCoordinatesX,
+                                   const float *objectCoordinatesY,
+                                   const float *objectCoordinatesZ,
+                                   unsigned int stride,
+                                   float *samples);
+
+      // throws if any of the M attribute indices is not valid for the volume
+      void checkAttributeIndices(const Volume<W> &volume,
+                                 unsigned int M,
+                                 const unsigned int *attributeIndices);
+
       template <int OW>
       typename std::enable_if<(OW < W), void>::type computeGradientAnyWidth(
           const int *valid,
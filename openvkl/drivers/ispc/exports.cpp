@@ -36,6 +36,10 @@ VKL_WRAP_DRIVER_REGISTRATION(ispc_driver_4, internal_ispc_4, ispc_4)
 
 VKL_WRAP_VOLUME_REGISTRATION(internal_amr_4, amr_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegular_4, structuredRegular_4)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegularCompressed_4,
+                             structuredRegularCompressed_4)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegularOutOfCore_4,
+                             structuredRegularOutOfCore_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredSpherical_4,
                              structuredSpherical_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_unstructured_4, unstructured_4)
@@ -53,6 +57,10 @@ VKL_WRAP_DRIVER_REGISTRATION(ispc_driver_8, internal_ispc_8, ispc_8)
 
 VKL_WRAP_VOLUME_REGISTRATION(internal_amr_8, amr_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegular_8, structuredRegular_8)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegularCompressed_8,
+                             structuredRegularCompressed_8)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegularOutOfCore_8,
+                             structuredRegularOutOfCore_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredSpherical_8,
                              structuredSpherical_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_unstructured_8, unstructured_8)
@@ -71,6 +79,10 @@ VKL_WRAP_DRIVER_REGISTRATION(ispc_driver_16, internal_ispc_16, ispc_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_amr_16, amr_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegular_16,
                              structuredRegular_16)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegularCompressed_16,
+                             structuredRegularCompressed_16)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegularOutOfCore_16,
+                             structuredRegularOutOfCore_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredSpherical_16,
                              structuredSpherical_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_unstructured_16, unstructured_16)
@@ -0,0 +1,248 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AcceleratorCache.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include "../../../common/logging.h"
+#include "ospcommon/tasking/parallel_for.h"
+
+using namespace ospcommon;
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // identifies cache files, and the version of their layout. caches are
+    // also specific to the library version, as the stored structures may
+    // change between versions.
+    static const char cacheMagic[8] = {
+        'V', 'K', 'L', 'A', 'C', 'C', 'E', 'L'};
+    static constexpr uint32_t cacheVersion = 1;
+
+    // inputs are hashed in chunks of this size
+    static constexpr size_t hashChunkSize = size_t(1) << 22;
+
+    // 64-bit MurmurHash2 (MurmurHash64A) of the given bytes
+    static uint64_t hashChunk(const char *bytes, size_t numBytes, uint64_t seed)
+    {
+      const uint64_t m = 0xc6a4a7935bd1e995ull;
+      const int r      = 47;
+
+      uint64_t h = seed ^ (numBytes * m);
+
+      const size_t numWords = numBytes / sizeof(uint64_t);
+
+      for (size_t i = 0; i < numWords; i++) {
+        uint64_t k;
+        std::memcpy(&k, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        h ^= k;
+        h *= m;
+      }
+
+      const size_t tailSize = numBytes % sizeof(uint64_t);
+
+      if (tailSize) {
+        uint64_t k = 0;
+        std::memcpy(&k, bytes + numWords * sizeof(uint64_t), tailSize);
+
+        h ^= k;
+        h *= m;
+      }
+
+      h ^= h >> r;
+      h *= m;
+      h ^= h >> r;
+
+      return h;
+    }
+
+    void AcceleratorCacheKey::addBytes(const void *data, size_t numBytes)
+    {
+      const char *bytes = static_cast<const char *>(data);
+
+      const size_t numChunks = (numBytes + hashChunkSize - 1) / hashChunkSize;
+
+      if (numChunks <= 1) {
+        hash = hashChunk(bytes, numBytes, hash);
+        return;
+      }
+
+      std::vector<uint64_t> chunkHashes(numChunks);
+
+      tasking::parallel_for(numChunks, [&](size_t chunkIndex) {
+        const size_t offset = chunkIndex * hashChunkSize;
+        chunkHashes[chunkIndex] =
+            hashChunk(bytes + offset,
+                      std::min(hashChunkSize, numBytes - offset),
+                      chunkIndex);
+      });
+
+      hash = hashChunk(reinterpret_cast<const char *>(chunkHashes.data()),
+                       numChunks * sizeof(uint64_t),
+                       hash);
+    }
+
+    void AcceleratorCacheKey::addString(const std::string &value)
+    {
+      add(value.size());
+      addBytes(value.data(), value.size());
+    }
+
+    void AcceleratorCacheKey::addData(const Data *data)
+    {
+      if (!data) {
+        add(VKL_UNKNOWN);
+        return;
+      }
+
+      add(data->dataType);
+      add(data->numItems);
+
+      if (data->dataType == VKL_DATA) {
+        for (size_t i = 0; i < data->numItems; i++) {
+          addData(data->begin<const Data *>()[i]);
+        }
+      } else {
+        addBytes(data->data, data->numBytes);
+      }
+    }
+
+    // a temporary file name next to the given file, unique across threads and
+    // processes writing the same cache concurrently
+    static std::string uniqueTempFilename(const std::string &filename)
+    {
+      static std::atomic<uint64_t> counter{0};
+      static const uint64_t writerId = []() {
+        std::random_device rd;
+        return (uint64_t(rd()) << 32) ^ rd();
+      }();
+
+      std::ostringstream os;
+      os << filename << "." << std::hex << writerId << "." << counter++
+         << ".tmp";
+      return os.str();
+    }
+
+    struct CacheFileHeader
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t libraryVersion[3];
+      uint32_t numBlocks;
+      uint64_t key;
+    };
+
+    bool loadAcceleratorCache(const std::string &filename,
+                              const AcceleratorCacheKey &key,
+                              std::vector<std::vector<char>> &blocks)
+    {
+      std::ifstream file(filename, std::ios::binary);
+
+      if (!file) {
+        return false;
+      }
+
+      CacheFileHeader header;
+      file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+      if (!file || std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) ||
+          header.version != cacheVersion ||
+          header.libraryVersion[0] != OPENVKL_VERSION_MAJOR ||
+          header.libraryVersion[1] != OPENVKL_VERSION_MINOR ||
+          header.libraryVersion[2] != OPENVKL_VERSION_PATCH ||
+          header.key != key.hash) {
+        postLogMessage(VKL_LOG_DEBUG)
+            << "ignoring acceleration structure cache " << filename
+            << ", which was written for different inputs";
+        return false;
+      }
+
+      std::vector<std::vector<char>> fileBlocks(header.numBlocks);
+
+      for (std::vector<char> &block : fileBlocks) {
+        uint64_t numBytes = 0;
+        file.read(reinterpret_cast<char *>(&numBytes), sizeof(numBytes));
+
+        if (file) {
+          block.resize(numBytes);
+          file.read(block.data(), numBytes);
+        }
+
+        if (!file) {
+          postLogMessage(VKL_LOG_WARNING)
+              << "ignoring truncated acceleration structure cache "
+              << filename;
+          return false;
+        }
+      }
+
+      blocks = std::move(fileBlocks);
+
+      return true;
+    }
+
+    void storeAcceleratorCache(const std::string &filename,
+                               const AcceleratorCacheKey &key,
+                               const std::vector<AcceleratorCacheBlock> &blocks)
+    {
+      CacheFileHeader header;
+      std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+      header.version           = cacheVersion;
+      header.libraryVersion[0] = OPENVKL_VERSION_MAJOR;
+      header.libraryVersion[1] = OPENVKL_VERSION_MINOR;
+      header.libraryVersion[2] = OPENVKL_VERSION_PATCH;
+      header.numBlocks         = blocks.size();
+      header.key               = key.hash;
+
+      // the file is written under a unique temporary name first, so that
+      // other processes never read a partially written cache, and concurrent
+      // writers do not write to the same file
+      const std::string tempFilename = uniqueTempFilename(filename);
+
+      {
+        std::ofstream file(tempFilename, std::ios::binary | std::ios::trunc);
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        for (const AcceleratorCacheBlock &block : blocks) {
+          const uint64_t numBytes = block.numBytes;
+          file.write(reinterpret_cast<const char *>(&numBytes),
+                     sizeof(numBytes));
+          file.write(static_cast<const char *>(block.data), numBytes);
+        }
+
+        file.close();
+
+        if (!file) {
+          postLogMessage(VKL_LOG_WARNING)
+              << "failed to write acceleration structure cache " << filename;
+          std::remove(tempFilename.c_str());
+          return;
+        }
+      }
+
+      // renaming replaces existing files atomically on POSIX systems, but
+      // fails for existing files on Windows
+#ifdef _WIN32
+      std::remove(filename.c_str());
+#endif
+
+      if (std::rename(tempFilename.c_str(), filename.c_str())) {
+        postLogMessage(VKL_LOG_WARNING)
+            << "failed to write acceleration structure cache " << filename;
+        std::remove(tempFilename.c_str());
+      }
+    }
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
@@ -0,0 +1,70 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../common/Data.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // hash of all inputs an acceleration structure is built from. cached
+    // acceleration structures are only used if their key matches; keys must
+    // therefore include everything the build depends on, including the
+    // layout of the stored structures.
+    //
+    // the hash is not cryptographic: it protects against stale caches, not
+    // against deliberately crafted inputs.
+    struct AcceleratorCacheKey
+    {
+      // large inputs are hashed in parallel chunks; the result does not
+      // depend on the number of threads
+      void addBytes(const void *data, size_t numBytes);
+
+      void addString(const std::string &value);
+
+      // hashes the data type and all items, recursing into data of type
+      // VKL_DATA. null data is hashed as well, to distinguish optional inputs
+      void addData(const Data *data);
+
+      template <typename T>
+      void add(const T &value);
+
+      uint64_t hash{0x9e3779b97f4a7c15ull};
+    };
+
+    // a contiguous part of an acceleration structure, stored as raw bytes
+    struct AcceleratorCacheBlock
+    {
+      const void *data;
+      size_t numBytes;
+    };
+
+    // reads the blocks stored in the given cache file. returns false without
+    // modifying blocks if the file does not exist, cannot be read, or was
+    // written for a different key.
+    bool loadAcceleratorCache(const std::string &filename,
+                              const AcceleratorCacheKey &key,
+                              std::vector<std::vector<char>> &blocks);
+
+    // writes the blocks to the given cache file, replacing any previous
+    // contents. failures are logged but not reported, as they do not affect
+    // the volume.
+    void storeAcceleratorCache(
+        const std::string &filename,
+        const AcceleratorCacheKey &key,
+        const std::vector<AcceleratorCacheBlock> &blocks);
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    template <typename T>
+    inline void AcceleratorCacheKey::add(const T &value)
+    {
+      addBytes(&value, sizeof(T));
+    }
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
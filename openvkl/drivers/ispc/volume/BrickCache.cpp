@@ -0,0 +1,245 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BrickCache.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include "../common/export_util.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    constexpr int BrickCache::brickWidthBitCount;
+    constexpr int BrickCache::brickWidth;
+    constexpr size_t BrickCache::voxelsPerBrick;
+    constexpr uint32_t BrickCache::invalidBrickIndex;
+    constexpr int32_t BrickCache::evictingPinCount;
+    constexpr int BrickCache::numHitCounters;
+
+    // assigns hit counters to threads round-robin
+    static int getHitCounterIndex(int numHitCounters)
+    {
+      static std::atomic<int> nextIndex{0};
+      thread_local int index = nextIndex++;
+      return index % numHitCounters;
+    }
+
+    BrickCache::BrickCache(const vec3i &dimensions,
+                           size_t maxCachedBricks,
+                           LoadVoxelsFunction loadVoxels)
+        : dimensions(dimensions), loadVoxels(loadVoxels)
+    {
+      // bricks cover cells, of which there is one less than voxels per
+      // dimension
+      bricksPerDimension = max(
+          (dimensions - 2 + brickWidth) / brickWidth, vec3i(1));
+
+      const size_t numBricks = bricksPerDimension.long_product();
+
+      if (numBricks > size_t(invalidBrickIndex)) {
+        throw std::runtime_error("too many bricks for brick cache");
+      }
+
+      if (maxCachedBricks == 0) {
+        throw std::runtime_error("brick cache must hold at least one brick");
+      }
+
+      brickSlots.reset(new std::atomic<int32_t>[numBricks]);
+      for (size_t i = 0; i < numBricks; i++) {
+        brickSlots[i] = -1;
+      }
+
+      numSlots = std::min(maxCachedBricks, numBricks);
+      slots.reset(new Slot[numSlots]);
+      voxels.resize(numSlots * voxelsPerBrick);
+    }
+
+    const vec3i &BrickCache::getBricksPerDimension() const
+    {
+      return bricksPerDimension;
+    }
+
+    const float *BrickCache::acquireBrick(uint32_t brickIndex)
+    {
+      const int32_t slotIndex =
+          brickSlots[brickIndex].load(std::memory_order_acquire);
+
+      if (slotIndex >= 0 && pinSlot(slotIndex, brickIndex)) {
+        hits[getHitCounterIndex(numHitCounters)].value.fetch_add(
+            1, std::memory_order_relaxed);
+        return getSlotVoxels(slotIndex);
+      }
+
+      return loadBrick(brickIndex);
+    }
+
+    void BrickCache::releaseBrick(uint32_t brickIndex)
+    {
+      // the brick cannot move to another slot while pinned
+      const int32_t slotIndex =
+          brickSlots[brickIndex].load(std::memory_order_relaxed);
+
+      slots[slotIndex].pinCount.fetch_sub(1, std::memory_order_release);
+    }
+
+    void BrickCache::getStatistics(uint64_t &hits,
+                                   uint64_t &misses,
+                                   uint64_t &evictions) const
+    {
+      hits = 0;
+      for (int i = 0; i < numHitCounters; i++) {
+        hits += this->hits[i].value.load(std::memory_order_relaxed);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      misses    = this->misses;
+      evictions = this->evictions;
+    }
+
+    bool BrickCache::pinSlot(int32_t slotIndex, uint32_t brickIndex)
+    {
+      Slot &slot = slots[slotIndex];
+
+      // the slot may have been reassigned since it was looked up; checking
+      // the brick after pinning ensures it cannot be reassigned while in use
+      if (slot.pinCount.fetch_add(1, std::memory_order_acquire) < 0 ||
+          slot.brickIndex.load(std::memory_order_relaxed) != brickIndex) {
+        slot.pinCount.fetch_sub(1, std::memory_order_release);
+        return false;
+      }
+
+      // avoid writing to the shared cache line if possible
+      if (!slot.referenced.load(std::memory_order_relaxed)) {
+        slot.referenced.store(true, std::memory_order_relaxed);
+      }
+
+      return true;
+    }
+
+    const float *BrickCache::loadBrick(uint32_t brickIndex)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      // another thread may have loaded the brick in the meantime
+      const int32_t residentSlotIndex =
+          brickSlots[brickIndex].load(std::memory_order_acquire);
+
+      if (residentSlotIndex >= 0 && pinSlot(residentSlotIndex, brickIndex)) {
+        hits[getHitCounterIndex(numHitCounters)].value.fetch_add(
+            1, std::memory_order_relaxed);
+        return getSlotVoxels(residentSlotIndex);
+      }
+
+      misses++;
+
+      const int32_t slotIndex = evictSlot();
+      Slot &slot              = slots[slotIndex];
+
+      const uint32_t evictedBrickIndex =
+          slot.brickIndex.load(std::memory_order_relaxed);
+
+      if (evictedBrickIndex != invalidBrickIndex) {
+        brickSlots[evictedBrickIndex].store(-1, std::memory_order_relaxed);
+        evictions++;
+      }
+
+      slot.brickIndex.store(brickIndex, std::memory_order_relaxed);
+
+      const box3i region = getBrickVoxelRange(brickIndex);
+      float *brickVoxels = getSlotVoxels(slotIndex);
+
+      loadVoxels(region, brickVoxels);
+
+      // the region is loaded densely; spread it out to the brick row and
+      // slice pitch, starting at the end so that no voxels are overwritten
+      // before being moved
+      const vec3i regionSize = region.size() + 1;
+
+      for (int z = regionSize.z - 1; z >= 0; z--) {
+        for (int y = regionSize.y - 1; y >= 0; y--) {
+          const size_t src = regionSize.x * (y + size_t(regionSize.y) * z);
+          const size_t dst =
+              (brickWidth + 1) * (y + size_t(brickWidth + 1) * z);
+
+          if (src != dst) {
+            std::memmove(brickVoxels + dst,
+                         brickVoxels + src,
+                         regionSize.x * sizeof(float));
+          }
+        }
+      }
+
+      slot.referenced.store(true, std::memory_order_relaxed);
+
+      // publishes the brick, pinned once for the caller
+      slot.pinCount.fetch_add(1 - evictingPinCount, std::memory_order_release);
+      brickSlots[brickIndex].store(slotIndex, std::memory_order_release);
+
+      return brickVoxels;
+    }
+
+    int32_t BrickCache::evictSlot()
+    {
+      for (size_t i = 0;; i++) {
+        // all slots may be pinned briefly by other threads
+        if (i > 0 && i % (2 * numSlots) == 0) {
+          std::this_thread::yield();
+        }
+
+        const int32_t slotIndex = int32_t(clockHand);
+        Slot &slot              = slots[slotIndex];
+
+        clockHand = (clockHand + 1) % numSlots;
+
+        if (slot.referenced.load(std::memory_order_relaxed)) {
+          slot.referenced.store(false, std::memory_order_relaxed);
+          continue;
+        }
+
+        int32_t expected = 0;
+        if (slot.pinCount.compare_exchange_strong(
+                expected, evictingPinCount, std::memory_order_acquire)) {
+          return slotIndex;
+        }
+      }
+    }
+
+    box3i BrickCache::getBrickVoxelRange(uint32_t brickIndex) const
+    {
+      const vec3i brick(
+          brickIndex % bricksPerDimension.x,
+          (brickIndex / bricksPerDimension.x) % bricksPerDimension.y,
+          brickIndex / (bricksPerDimension.x * bricksPerDimension.y));
+
+      const vec3i lower = brick * brickWidth;
+      const vec3i upper = min(lower + brickWidth, dimensions - 1);
+
+      return box3i(lower, upper);
+    }
+
+    float *BrickCache::getSlotVoxels(int32_t slotIndex)
+    {
+      return voxels.data() + slotIndex * voxelsPerBrick;
+    }
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
+
+// called from the out-of-core layout of SharedStructuredVolume
+extern "C" const float *EXPORT_UNIQUE(BrickCache_acquireBrick,
+                                      void *brickCache,
+                                      uint32_t brickIndex)
+{
+  return static_cast<openvkl::ispc_driver::BrickCache *>(brickCache)
+      ->acquireBrick(brickIndex);
+}
+
+extern "C" void EXPORT_UNIQUE(BrickCache_releaseBrick,
+                              void *brickCache,
+                              uint32_t brickIndex)
+{
+  static_cast<openvkl::ispc_driver::BrickCache *>(brickCache)
+      ->releaseBrick(brickIndex);
+}
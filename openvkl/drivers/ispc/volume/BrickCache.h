@@ -0,0 +1,117 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../common/math.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // loads the voxels of the given (inclusive) region of voxel indices, as
+    // floats in x-fastest order. must not throw, as it is called from ISPC
+    // code; read errors should produce NaN voxels instead.
+    using LoadVoxelsFunction =
+        std::function<void(const box3i &region, float *voxels)>;
+
+    // bounded cache of volume bricks for out-of-core structured volumes.
+    // bricks are loaded on demand and evicted in CLOCK order (an
+    // approximation of least recently used) once the cache is full.
+    //
+    // looking up a resident brick does not take any locks. loading bricks is
+    // serialized, which keeps the voxel source simple.
+    struct BrickCache
+    {
+      // must match SSV_CACHE_BRICK_WIDTH_BITCOUNT
+      static constexpr int brickWidthBitCount = 6;
+      static constexpr int brickWidth         = 1 << brickWidthBitCount;
+
+      // bricks also hold the voxels on their upper faces, so that all voxels
+      // needed for trilinear interpolation within a cell are in one brick
+      static constexpr size_t voxelsPerBrick = size_t(brickWidth + 1) *
+                                               (brickWidth + 1) *
+                                               (brickWidth + 1);
+
+      BrickCache(const vec3i &dimensions,
+                 size_t maxCachedBricks,
+                 LoadVoxelsFunction loadVoxels);
+
+      BrickCache(const BrickCache &) = delete;
+      BrickCache &operator=(const BrickCache &) = delete;
+
+      const vec3i &getBricksPerDimension() const;
+
+      // returns the voxels of the given brick, loading it if it is not
+      // resident. the brick is not evicted until released again.
+      const float *acquireBrick(uint32_t brickIndex);
+
+      void releaseBrick(uint32_t brickIndex);
+
+      // hits, misses and evictions since the cache was created
+      void getStatistics(uint64_t &hits,
+                         uint64_t &misses,
+                         uint64_t &evictions) const;
+
+     private:
+      struct Slot
+      {
+        // number of callers using the slot, or negative while the slot is
+        // being reassigned to another brick
+        std::atomic<int32_t> pinCount{0};
+
+        std::atomic<uint32_t> brickIndex{invalidBrickIndex};
+
+        // CLOCK reference bit, set on each access
+        std::atomic<bool> referenced{false};
+      };
+
+      // padded to avoid false sharing between threads
+      struct alignas(64) HitCounter
+      {
+        std::atomic<uint64_t> value{0};
+      };
+
+      static constexpr uint32_t invalidBrickIndex = uint32_t(-1);
+      static constexpr int32_t evictingPinCount   = -(1 << 30);
+      static constexpr int numHitCounters         = 16;
+
+      bool pinSlot(int32_t slotIndex, uint32_t brickIndex);
+
+      const float *loadBrick(uint32_t brickIndex);
+
+      // returns a slot without users, with its pin count set to
+      // evictingPinCount
+      int32_t evictSlot();
+
+      box3i getBrickVoxelRange(uint32_t brickIndex) const;
+
+      float *getSlotVoxels(int32_t slotIndex);
+
+      vec3i dimensions;
+      vec3i bricksPerDimension;
+
+      LoadVoxelsFunction loadVoxels;
+
+      // resident slot per brick, or -1
+      std::unique_ptr<std::atomic<int32_t>[]> brickSlots;
+
+      size_t numSlots{0};
+      std::unique_ptr<Slot[]> slots;
+      std::vector<float> voxels;
+
+      HitCounter hits[numHitCounters];
+
+      // protected by mutex
+      mutable std::mutex mutex;
+      size_t clockHand{0};
+      uint64_t misses{0};
+      uint64_t evictions{0};
+    };
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
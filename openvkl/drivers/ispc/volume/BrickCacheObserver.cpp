@@ -0,0 +1,46 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BrickCacheObserver.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    BrickCacheObserver::BrickCacheObserver(
+        ManagedObject &target, std::shared_ptr<const BrickCache> brickCache)
+        : target(&target), brickCache(brickCache)
+    {
+      this->target->refInc();
+    }
+
+    BrickCacheObserver::~BrickCacheObserver()
+    {
+      target->refDec();
+    }
+
+    const void *BrickCacheObserver::map()
+    {
+      uint64_t hits, misses, evictions;
+      brickCache->getStatistics(hits, misses, evictions);
+
+      statistics[0] = hits;
+      statistics[1] = misses;
+      statistics[2] = evictions;
+
+      return statistics;
+    }
+
+    void BrickCacheObserver::unmap() {}
+
+    size_t BrickCacheObserver::getNumElements() const
+    {
+      return 3;
+    }
+
+    VKLDataType BrickCacheObserver::getElementType() const
+    {
+      return VKL_ULONG;
+    }
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
@@ -0,0 +1,42 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include "../common/Observer.h"
+#include "BrickCache.h"
+#include "openvkl/ispc_cpp_interop.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    /*
+     * The brick cache observer returns the number of cache hits, misses and
+     * evictions, in this order, as of the time it is mapped.
+     */
+    struct BrickCacheObserver : public Observer
+    {
+      BrickCacheObserver(ManagedObject &target,
+                         std::shared_ptr<const BrickCache> brickCache);
+
+      BrickCacheObserver(BrickCacheObserver &&) = delete;
+      BrickCacheObserver &operator=(BrickCacheObserver &&) = delete;
+      BrickCacheObserver(const BrickCacheObserver &)       = delete;
+      BrickCacheObserver &operator=(const BrickCacheObserver &) = delete;
+
+      ~BrickCacheObserver();
+
+      const void *map() override;
+      void unmap() override;
+      VKLDataType getElementType() const override;
+      size_t getNumElements() const override;
+
+     private:
+      ManagedObject *target{nullptr};
+      std::shared_ptr<const BrickCache> brickCache;
+      vkl_uint64 statistics[3];
+    };
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
@@ -0,0 +1,113 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "StructuredRegularCompressedVolume.h"
+#include "../common/export_util.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    template <int W>
+    void StructuredRegularCompressedVolume<W>::commit()
+    {
+      StructuredVolume<W>::commit();
+
+      if (!this->ispcEquivalent) {
+        this->ispcEquivalent = CALL_ISPC(SharedStructuredVolume_Constructor);
+
+        if (!this->ispcEquivalent) {
+          throw std::runtime_error(
+              "could not create ISPC-side object for "
+              "StructuredRegularCompressedVolume");
+        }
+      }
+
+      bool success = CALL_ISPC(SharedStructuredVolume_set,
+                               this->ispcEquivalent,
+                               this->voxelData->data,
+                               this->voxelData->dataType,
+                               (const ispc::vec3i &)this->dimensions,
+                               ispc::structured_regular,
+                               (const ispc::vec3f &)this->gridOrigin,
+                               (const ispc::vec3f &)this->gridSpacing);
+
+      if (!success) {
+        CALL_ISPC(SharedStructuredVolume_Destructor, this->ispcEquivalent);
+        this->ispcEquivalent = nullptr;
+        this->accelerator    = nullptr;
+
+        throw std::runtime_error(
+            "failed to commit StructuredRegularCompressedVolume");
+      }
+
+      buildCompressedLayout();
+
+      const VKLFilter filter = (VKLFilter)this->template getParam<int>(
+          "filter", VKL_FILTER_TRILINEAR);
+
+      success = CALL_ISPC(
+          SharedStructuredVolume_setFilter, this->ispcEquivalent, filter);
+
+      if (!success) {
+        throw std::runtime_error(
+            "unsupported filter for StructuredRegularCompressedVolume");
+      }
+
+      // only single attributes are supported by the compressed layout
+      this->commitAttributes();
+
+      const VKLGradientMethod gradientMethod =
+          (VKLGradientMethod)this->template getParam<int>(
+              "gradientMethod", VKL_GRADIENT_ANALYTIC);
+
+      // the ISPC-side enum has matching values
+      success = CALL_ISPC(
+          SharedStructuredVolume_setGradientMethod,
+          this->ispcEquivalent,
+          (ispc::SharedStructuredVolumeGradientMethod)gradientMethod);
+
+      if (!success) {
+        throw std::runtime_error(
+            "unknown gradientMethod for StructuredRegularCompressedVolume");
+      }
+
+      // must be last; macrocell value ranges are computed from the compressed
+      // bricks, and are not cached as they depend on the compression
+      this->buildAccelerator();
+    }
+
+    template <int W>
+    void StructuredRegularCompressedVolume<W>::buildCompressedLayout()
+    {
+      const size_t numBytes =
+          CALL_ISPC(SharedStructuredVolume_getCompressedVoxelDataSize,
+                    this->ispcEquivalent);
+
+      const int numBricks = CALL_ISPC(SharedStructuredVolume_getNumVoxelBricks,
+                                      this->ispcEquivalent);
+
+      codes.resize(numBytes);
+      compressedBricks.resize(numBricks);
+
+      // bricks are encoded from the linear voxel data, so this must happen
+      // before switching to the compressed layout
+      tasking::parallel_for(numBricks, [&](int taskIndex) {
+        CALL_ISPC(SharedStructuredVolume_compressVoxelBrick,
+                  this->ispcEquivalent,
+                  codes.data(),
+                  compressedBricks.data(),
+                  taskIndex);
+      });
+
+      CALL_ISPC(SharedStructuredVolume_setCompressedLayout,
+                this->ispcEquivalent,
+                codes.data(),
+                compressedBricks.data());
+    }
+
+    VKL_REGISTER_VOLUME(StructuredRegularCompressedVolume<VKL_TARGET_WIDTH>,
+                        CONCAT1(internal_structuredRegularCompressed_,
+                                VKL_TARGET_WIDTH))
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
@@ -0,0 +1,39 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "StructuredRegularVolume.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // structured regular volume which keeps a block-compressed copy of the
+    // voxel data: voxels are quantized to 8 bits over the value range of each
+    // voxel brick. the input voxel data is only accessed during commit.
+    template <int W>
+    struct StructuredRegularCompressedVolume
+        : public StructuredRegularVolume<W>
+    {
+      void commit() override;
+
+      // the compressed voxel data is only updated on commit
+      void invalidateRegion(const box3i &region) override
+      {
+        throw std::runtime_error(
+            "invalidateRegion() is not supported for compressed volumes; "
+            "recommit the volume instead");
+      }
+
+     private:
+      void buildCompressedLayout();
+
+      // one code per voxel, in the bricked voxel order
+      std::vector<uint8_t> codes;
+
+      // decoding parameters per voxel brick
+      std::vector<ispc::CompressedVoxelBrick> compressedBricks;
+    };
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
@@ -0,0 +1,272 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "StructuredRegularOutOfCoreVolume.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include "../common/export_util.h"
+#include "../common/logging.h"
+#include "BrickCacheObserver.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // converts one row of voxels read from a file to floats
+    template <typename T>
+    static void convertVoxels(const char *source,
+                              size_t numVoxels,
+                              float *voxels)
+    {
+      for (size_t i = 0; i < numVoxels; i++) {
+        T value;
+        std::memcpy(&value, source + i * sizeof(T), sizeof(T));
+        voxels[i] = float(value);
+      }
+    }
+
+    // reads voxels from a raw file in x-fastest order. loads are serialized
+    // by the brick cache, so a single stream can be shared by all loads.
+    struct FileVoxelLoader
+    {
+      FileVoxelLoader(const std::string &filename,
+                      size_t offset,
+                      const vec3i &dimensions,
+                      VKLDataType voxelType)
+          : file(filename, std::ios::binary),
+            filename(filename),
+            offset(offset),
+            dimensions(dimensions),
+            voxelType(voxelType)
+      {
+        if (!file) {
+          throw std::runtime_error("could not open file " + filename);
+        }
+
+        if (voxelType != VKL_UCHAR && voxelType != VKL_SHORT &&
+            voxelType != VKL_USHORT && voxelType != VKL_FLOAT &&
+            voxelType != VKL_DOUBLE) {
+          throw std::runtime_error("unsupported voxelType for file " +
+                                   filename);
+        }
+
+        file.seekg(0, std::ios::end);
+
+        const size_t fileSize = size_t(file.tellg());
+        const size_t numBytes = dimensions.long_product() * sizeOf(voxelType);
+
+        if (offset + numBytes > fileSize) {
+          throw std::runtime_error("file " + filename +
+                                   " is too small for the volume dimensions");
+        }
+      }
+
+      void operator()(const box3i &region, float *voxels)
+      {
+        const size_t voxelSize = sizeOf(voxelType);
+        const size_t rowLength = region.upper.x - region.lower.x + 1;
+
+        row.resize(rowLength * voxelSize);
+
+        for (int z = region.lower.z; z <= region.upper.z; z++) {
+          for (int y = region.lower.y; y <= region.upper.y; y++) {
+            const size_t index =
+                region.lower.x +
+                dimensions.x * (y + size_t(dimensions.y) * z);
+
+            file.seekg(offset + index * voxelSize);
+            file.read(row.data(), row.size());
+
+            if (!file) {
+              // errors cannot be reported to the caller, as loads happen
+              // during sampling
+              postLogMessage(VKL_LOG_ERROR)
+                  << "failed to read voxels from file " << filename;
+
+              file.clear();
+              std::fill(voxels,
+                        voxels + rowLength,
+                        std::numeric_limits<float>::quiet_NaN());
+            } else if (voxelType == VKL_UCHAR) {
+              convertVoxels<uint8_t>(row.data(), rowLength, voxels);
+            } else if (voxelType == VKL_SHORT) {
+              convertVoxels<int16_t>(row.data(), rowLength, voxels);
+            } else if (voxelType == VKL_USHORT) {
+              convertVoxels<uint16_t>(row.data(), rowLength, voxels);
+            } else if (voxelType == VKL_FLOAT) {
+              convertVoxels<float>(row.data(), rowLength, voxels);
+            } else {
+              convertVoxels<double>(row.data(), rowLength, voxels);
+            }
+
+            voxels += rowLength;
+          }
+        }
+      }
+
+     private:
+      std::ifstream file;
+      std::string filename;
+      size_t offset;
+      vec3i dimensions;
+      VKLDataType voxelType;
+      std::vector<char> row;
+    };
+
+    template <int W>
+    void StructuredRegularOutOfCoreVolume<W>::commit()
+    {
+      this->commitGridParameters();
+
+      const int maxCachedBricks =
+          this->template getParam<int>("maxCachedBricks", 256);
+
+      if (maxCachedBricks < 1) {
+        throw std::runtime_error("maxCachedBricks must be at least 1");
+      }
+
+      // the ISPC-side volume is switched to the new brick cache below
+      brickCache = std::make_shared<BrickCache>(
+          this->dimensions, maxCachedBricks, createLoadVoxelsFunction());
+
+      if (!this->ispcEquivalent) {
+        this->ispcEquivalent = CALL_ISPC(SharedStructuredVolume_Constructor);
+
+        if (!this->ispcEquivalent) {
+          throw std::runtime_error(
+              "could not create ISPC-side object for "
+              "StructuredRegularOutOfCoreVolume");
+        }
+      }
+
+      // bricks are always held as floats
+      bool success = CALL_ISPC(SharedStructuredVolume_set,
+                               this->ispcEquivalent,
+                               nullptr,
+                               VKL_FLOAT,
+                               (const ispc::vec3i &)this->dimensions,
+                               ispc::structured_regular,
+                               (const ispc::vec3f &)this->gridOrigin,
+                               (const ispc::vec3f &)this->gridSpacing);
+
+      if (!success) {
+        CALL_ISPC(SharedStructuredVolume_Destructor, this->ispcEquivalent);
+        this->ispcEquivalent = nullptr;
+        this->accelerator    = nullptr;
+
+        throw std::runtime_error(
+            "failed to commit StructuredRegularOutOfCoreVolume");
+      }
+
+      CALL_ISPC(SharedStructuredVolume_setOutOfCoreLayout,
+                this->ispcEquivalent,
+                brickCache.get(),
+                (const ispc::vec3i &)brickCache->getBricksPerDimension());
+
+      const VKLFilter filter = (VKLFilter)this->template getParam<int>(
+          "filter", VKL_FILTER_TRILINEAR);
+
+      success = CALL_ISPC(
+          SharedStructuredVolume_setFilter, this->ispcEquivalent, filter);
+
+      if (!success) {
+        throw std::runtime_error(
+            "unsupported filter for StructuredRegularOutOfCoreVolume");
+      }
+
+      const VKLGradientMethod gradientMethod =
+          (VKLGradientMethod)this->template getParam<int>(
+              "gradientMethod", VKL_GRADIENT_ANALYTIC);
+
+      // the ISPC-side enum has matching values
+      success = CALL_ISPC(
+          SharedStructuredVolume_setGradientMethod,
+          this->ispcEquivalent,
+          (ispc::SharedStructuredVolumeGradientMethod)gradientMethod);
+
+      if (!success) {
+        throw std::runtime_error(
+            "unknown gradientMethod for StructuredRegularOutOfCoreVolume");
+      }
+
+      // must be last; this reads all bricks once through the cache. the
+      // acceleration structure is not cached, as the voxels cannot be hashed
+      // without reading them.
+      this->buildAccelerator();
+    }
+
+    template <int W>
+    VKLObserver StructuredRegularOutOfCoreVolume<W>::newObserver(
+        const char *type)
+    {
+      if (!brickCache)
+        throw std::runtime_error(
+            "Trying to create an observer on an out-of-core volume that was "
+            "not committed.");
+
+      const std::string t(type);
+      if (t == "BrickCacheStatistics") {
+        return (VKLObserver) new BrickCacheObserver(*this, brickCache);
+      } else {
+        return StructuredRegularVolume<W>::newObserver(type);
+      }
+    }
+
+    template <int W>
+    LoadVoxelsFunction
+    StructuredRegularOutOfCoreVolume<W>::createLoadVoxelsFunction()
+    {
+      const std::string filename =
+          this->template getParam<std::string>("filename", "");
+
+      VKLLoadVoxelsFunction loadVoxelsFunction =
+          (VKLLoadVoxelsFunction)this->template getParam<void *>(
+              "loadVoxelsFunction", nullptr);
+
+      if (!filename.empty()) {
+        // offsets may exceed 2GB, and are therefore set with vklSetSize();
+        // offsets set with vklSetInt() are accepted as well. getParam()
+        // returns the given default if the parameter has a different type, so
+        // an int offset is read by the first lookup and passed on as the
+        // default of the second, which returns a size_t offset if set.
+        const int intOffset = this->template getParam<int>("fileOffset", 0);
+
+        if (intOffset < 0) {
+          throw std::runtime_error("fileOffset must not be negative");
+        }
+
+        const size_t offset =
+            this->template getParam<size_t>("fileOffset", intOffset);
+
+        const VKLDataType voxelType = (VKLDataType)this->template getParam<int>(
+            "voxelType", VKL_FLOAT);
+
+        // std::function requires copyable targets
+        auto loader = std::make_shared<FileVoxelLoader>(
+            filename, offset, this->dimensions, voxelType);
+
+        return [=](const box3i &region, float *voxels) {
+          (*loader)(region, voxels);
+        };
+      } else if (loadVoxelsFunction) {
+        void *userData =
+            this->template getParam<void *>("loadVoxelsUserData", nullptr);
+
+        return [=](const box3i &region, float *voxels) {
+          loadVoxelsFunction(
+              userData, reinterpret_cast<const vkl_box3i *>(&region), voxels);
+        };
+      }
+
+      throw std::runtime_error(
+          "no filename or loadVoxelsFunction set on out-of-core volume");
+    }
+
+    VKL_REGISTER_VOLUME(StructuredRegularOutOfCoreVolume<VKL_TARGET_WIDTH>,
+                        CONCAT1(internal_structuredRegularOutOfCore_,
+                                VKL_TARGET_WIDTH))
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
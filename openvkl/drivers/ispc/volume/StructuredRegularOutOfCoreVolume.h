@@ -0,0 +1,40 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BrickCache.h"
+#include "StructuredRegularVolume.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // structured regular volume whose voxels are not held in memory, but
+    // loaded brick-wise from a file or an application callback into a
+    // bounded BrickCache. macrocell value ranges are computed on commit and
+    // stay resident, so empty space skipping does not load any bricks.
+    template <int W>
+    struct StructuredRegularOutOfCoreVolume
+        : public StructuredRegularVolume<W>
+    {
+      void commit() override;
+
+      // cached bricks are not reloaded from the voxel source
+      void invalidateRegion(const box3i &region) override
+      {
+        throw std::runtime_error(
+            "invalidateRegion() is not supported for out-of-core volumes; "
+            "recommit the volume instead");
+      }
+
+      VKLObserver newObserver(const char *type) override;
+
+     private:
+      LoadVoxelsFunction createLoadVoxelsFunction();
+
+      // shared with observers, which may outlive a recommit
+      std::shared_ptr<BrickCache> brickCache;
+    };
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
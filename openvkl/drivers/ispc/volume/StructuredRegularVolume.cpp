@@ -33,12 +33,109 @@ namespace openvkl {
       if (!success) {
         CALL_ISPC(SharedStructuredVolume_Destructor, this->ispcEquivalent);
         this->ispcEquivalent = nullptr;
+        this->accelerator    = nullptr;
 
         throw std::runtime_error("failed to commit StructuredRegularVolume");
       }
 
-      // must be last
-      this->buildAccelerator();
+      const VKLStructuredLayout layout =
+          (VKLStructuredLayout)this->template getParam<int>(
+              "layout", VKL_STRUCTURED_LAYOUT_LINEAR);
+
+      if (layout == VKL_STRUCTURED_LAYOUT_BRICKED) {
+        buildBrickedLayout();
+      } else if (layout == VKL_STRUCTURED_LAYOUT_MORTON) {
+        buildMortonLayout();
+      } else if (layout == VKL_STRUCTURED_LAYOUT_LINEAR) {
+        reorderedVoxelData.clear();
+        reorderedVoxelData.shrink_to_fit();
+      } else {
+        throw std::runtime_error("unknown layout for StructuredRegularVolume");
+      }
+
+      const VKLFilter filter = (VKLFilter)this->template getParam<int>(
+          "filter", VKL_FILTER_TRILINEAR);
+
+      success = CALL_ISPC(
+          SharedStructuredVolume_setFilter, this->ispcEquivalent, filter);
+
+      if (!success) {
+        throw std::runtime_error(
+            "unsupported filter for StructuredRegularVolume");
+      }
+
+      this->commitAttributes();
+
+      const VKLGradientMethod gradientMethod =
+          (VKLGradientMethod)this->template getParam<int>(
+              "gradientMethod", VKL_GRADIENT_ANALYTIC);
+
+      // the ISPC-side enum has matching values
+      success = CALL_ISPC(
+          SharedStructuredVolume_setGradientMethod,
+          this->ispcEquivalent,
+          (ispc::SharedStructuredVolumeGradientMethod)gradientMethod);
+
+      if (!success) {
+        throw std::runtime_error(
+            "unknown gradientMethod for StructuredRegularVolume");
+      }
+
+      this->buildAccelerator("structuredRegular");
+
+      // replicas share the accelerator
+      if (reorderedVoxelData.empty()) {
+        this->buildReplicas(this->voxelData->data, this->voxelData->numBytes);
+      } else {
+        this->buildReplicas(reorderedVoxelData.data(),
+                            reorderedVoxelData.size());
+      }
+    }
+
+    template <int W>
+    void StructuredRegularVolume<W>::buildBrickedLayout()
+    {
+      const size_t numBytes = CALL_ISPC(
+          SharedStructuredVolume_getBrickedVoxelDataSize, this->ispcEquivalent);
+
+      const int numBricks = CALL_ISPC(SharedStructuredVolume_getNumVoxelBricks,
+                                      this->ispcEquivalent);
+
+      reorderedVoxelData.resize(numBytes);
+
+      tasking::parallel_for(numBricks, [&](int taskIndex) {
+        CALL_ISPC(SharedStructuredVolume_brickVoxelData,
+                  this->ispcEquivalent,
+                  reorderedVoxelData.data(),
+                  taskIndex);
+      });
+
+      CALL_ISPC(SharedStructuredVolume_setBrickedLayout,
+                this->ispcEquivalent,
+                reorderedVoxelData.data());
+    }
+
+    template <int W>
+    void StructuredRegularVolume<W>::buildMortonLayout()
+    {
+      const size_t numBytes = CALL_ISPC(
+          SharedStructuredVolume_getMortonVoxelDataSize, this->ispcEquivalent);
+
+      const int numBricks = CALL_ISPC(SharedStructuredVolume_getNumMortonBricks,
+                                      this->ispcEquivalent);
+
+      reorderedVoxelData.resize(numBytes);
+
+      tasking::parallel_for(numBricks, [&](int taskIndex) {
+        CALL_ISPC(SharedStructuredVolume_mortonVoxelData,
+                  this->ispcEquivalent,
+                  reorderedVoxelData.data(),
+                  taskIndex);
+      });
+
+      CALL_ISPC(SharedStructuredVolume_setMortonLayout,
+                this->ispcEquivalent,
+                reorderedVoxelData.data());
     }
 
     VKL_REGISTER_VOLUME(StructuredRegularVolume<VKL_TARGET_WIDTH>,
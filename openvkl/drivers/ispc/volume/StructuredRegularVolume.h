@@ -59,6 +59,16 @@ namespace openvkl {
                        vVKLHitIteratorN<W> &iterator,
                        vVKLHitN<W> &hit,
                        vintn<W> &result) override;
+
+      void invalidateRegion(const box3i &region) override;
+
+     private:
+      void buildBrickedLayout();
+      void buildMortonLayout();
+
+      // internal copy of the voxel data for the bricked or Morton layout, if
+      // enabled
+      std::vector<uint8_t> reorderedVoxelData;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -144,6 +154,22 @@ namespace openvkl {
           iterator, valid, this, origin, direction, tRange, valueSelector);
     }
 
+    template <int W>
+    inline void StructuredRegularVolume<W>::invalidateRegion(
+        const box3i &region)
+    {
+      // the bricked and Morton layouts keep their own copy of the voxel data,
+      // which does not reflect modifications of the voxel data set on the
+      // volume
+      if (!reorderedVoxelData.empty()) {
+        throw std::runtime_error(
+            "invalidateRegion() requires the linear layout; recommit the "
+            "volume instead");
+      }
+
+      StructuredVolume<W>::invalidateRegion(region);
+    }
+
     template <int W>
     inline void StructuredRegularVolume<W>::iterateHitU(
         vVKLHitIteratorN<1> &iterator, vVKLHitN<1> &hit, vintn<1> &result)
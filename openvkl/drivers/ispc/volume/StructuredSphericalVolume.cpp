@@ -84,12 +84,15 @@ namespace openvkl {
       if (!success) {
         CALL_ISPC(SharedStructuredVolume_Destructor, this->ispcEquivalent);
         this->ispcEquivalent = nullptr;
+        this->accelerator    = nullptr;
 
         throw std::runtime_error("failed to commit StructuredSphericalVolume");
       }
 
+      this->commitAttributes();
+
       // must be last
-      this->buildAccelerator();
+      this->buildAccelerator("structuredSpherical");
     }
 
     VKL_REGISTER_VOLUME(StructuredSphericalVolume<VKL_TARGET_WIDTH>,
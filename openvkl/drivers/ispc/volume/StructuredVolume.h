@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <cstring>
 #include "../common/Data.h"
+#include "../common/Numa.h"
 #include "../common/export_util.h"
 #include "../common/math.h"
+#include "AcceleratorCache.h"
 #include "GridAccelerator_ispc.h"
 #include "SharedStructuredVolume_ispc.h"
 #include "Volume.h"
@@ -32,12 +35,74 @@ namespace openvkl {
                             const vvec3fn<W> &objectCoordinates,
                             vvec3fn<W> &gradients) const override;
 
+      void computeSampleN(unsigned int N,
+                          const float *objectCoordinatesX,
+                          const float *objectCoordinatesY,
+                          const float *objectCoordinatesZ,
+                          unsigned int stride,
+                          float *samples) const override;
+
+      void computeSampleAndGradientN(unsigned int N,
+                                     const vvec3fn<1> *objectCoordinates,
+                                     float *samples,
+                                     vvec3fn<1> *gradients) const override;
+
+      unsigned int getNumAttributes() const override;
+
+      void computeSampleM(const vvec3fn<1> &objectCoordinates,
+                          float *samples,
+                          unsigned int M,
+                          const unsigned int *attributeIndices) const override;
+
+      void computeSampleMN(unsigned int N,
+                           const vvec3fn<1> *objectCoordinates,
+                           unsigned int M,
+                           const unsigned int *attributeIndices,
+                           size_t samplesStride,
+                           float *samples) const override;
+
+      void computeSampleAtTime(const vvec3fn<1> &objectCoordinates,
+                               float time,
+                               vfloatn<1> &sample) const override;
+
+      void computeSampleAtTimeN(unsigned int N,
+                                const vvec3fn<1> *objectCoordinates,
+                                const float *times,
+                                float *samples) const override;
+
       box3f getBoundingBox() const override;
 
       range1f getValueRange() const override;
 
+      void invalidateRegion(const box3i &region) override;
+
      protected:
-      void buildAccelerator();
+      // reads the grid and macrocell parameters; commit() additionally
+      // requires voxel data
+      void commitGridParameters();
+
+      // passes all attributes and timesteps to the ISPC-side volume; must be
+      // called after the layout and filter are set
+      void commitAttributes();
+
+      // if the acceleratorCacheFile parameter is set and a cache type is
+      // given, the acceleration structure is loaded from the file if it was
+      // written for the same inputs, and built and written to the file
+      // otherwise. volumes whose macrocell value ranges depend on more than
+      // the voxel data and the grid and filter parameters must not use a
+      // cache type of another volume.
+      void buildAccelerator(const char *cacheType = nullptr);
+
+      // if the numaReplicas parameter is set, copies the voxel data of the
+      // current layout (numBytes starting at voxels) to each NUMA node; the
+      // sampling APIs then use the copy on the calling thread's node. must be
+      // called after buildAccelerator().
+      void buildReplicas(const void *voxels, size_t numBytes);
+
+      void releaseReplicas();
+
+      // ISPC-side volume used by the sampling APIs
+      void *getSamplingEquivalent() const;
 
       range1f valueRange{empty};
 
@@ -46,6 +111,47 @@ namespace openvkl {
       vec3f gridOrigin;
       vec3f gridSpacing;
       Data *voxelData{nullptr};
+
+      // all attributes, the first being voxelData. the value range and
+      // acceleration structure only consider the first attribute.
+      std::vector<Data *> attributes;
+
+      // all timesteps of time-varying volumes, the first being voxelData;
+      // empty otherwise. the value range and acceleration structure are
+      // conservative over all timesteps.
+      std::vector<Data *> timesteps;
+
+      // referenced by the ISPC-side volume
+      std::vector<const void *> attributesDataPointers;
+      std::vector<int> attributesTypes;
+      std::vector<const void *> timestepsDataPointers;
+      std::vector<int> timestepsTypes;
+
+      // width of the GridAccelerator macrocells, in volume cells
+      int macrocellWidth;
+
+      // owned by the ISPC-side volume; valid after buildAccelerator()
+      void *accelerator{nullptr};
+
+     private:
+      // the data objects held by data of type VKL_DATA
+      static std::vector<Data *> getDataObjects(const Data &data,
+                                                const std::string &name);
+
+      AcceleratorCacheKey getAcceleratorCacheKey(const char *cacheType);
+
+      // returns false if the cache does not match the current accelerator
+      bool loadAccelerator(const std::string &cacheFilename,
+                           const AcceleratorCacheKey &cacheKey);
+
+      void storeAccelerator(const std::string &cacheFilename,
+                            const AcceleratorCacheKey &cacheKey) const;
+
+      // per NUMA node if replicated, empty otherwise: copies of the ISPC-side
+      // volume, each referencing a copy of the voxel data on its node
+      std::vector<void *> ispcReplicas;
+      std::vector<void *> voxelReplicas;
+      size_t voxelReplicaSize{0};
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -53,6 +159,8 @@ namespace openvkl {
     template <int W>
     StructuredVolume<W>::~StructuredVolume()
     {
+      releaseReplicas();
+
       if (this->ispcEquivalent) {
         CALL_ISPC(SharedStructuredVolume_Destructor, this->ispcEquivalent);
       }
@@ -61,20 +169,95 @@ namespace openvkl {
     template <int W>
     inline void StructuredVolume<W>::commit()
     {
-      dimensions  = this->template getParam<vec3i>("dimensions", vec3i(128));
-      gridOrigin  = this->template getParam<vec3f>("gridOrigin", vec3f(0.f));
-      gridSpacing = this->template getParam<vec3f>("gridSpacing", vec3f(1.f));
+      commitGridParameters();
+
+      // replicas share state with the ISPC-side volume, which is updated below
+      releaseReplicas();
 
-      voxelData = (Data *)this->template getParam<ManagedObject::VKL_PTR>(
+      Data *data = (Data *)this->template getParam<ManagedObject::VKL_PTR>(
           "data", nullptr);
 
-      if (!voxelData) {
+      Data *timestepData =
+          (Data *)this->template getParam<ManagedObject::VKL_PTR>(
+              "timestepData", nullptr);
+
+      timesteps.clear();
+
+      // time-varying volumes have one data object per timestep, instead of
+      // data
+      if (timestepData) {
+        if (data) {
+          throw std::runtime_error(
+              "data and timestepData cannot both be set on volume");
+        }
+
+        timesteps = getDataObjects(*timestepData, "timestepData");
+        data      = timesteps[0];
+      }
+
+      if (!data) {
         throw std::runtime_error("no data set on volume");
       }
 
-      if (voxelData->size() != this->dimensions.long_product()) {
+      // multiple attributes are given as data of one data object per
+      // attribute
+      if (data->dataType == VKL_DATA) {
+        attributes = getDataObjects(*data, "data");
+      } else {
+        attributes = {data};
+      }
+
+      for (const Data *attribute : attributes) {
+        if (attribute->size() != this->dimensions.long_product()) {
+          throw std::runtime_error(
+              "incorrect data size for provided volume dimensions");
+        }
+      }
+
+      for (const Data *timestep : timesteps) {
+        if (timestep->size() != this->dimensions.long_product()) {
+          throw std::runtime_error(
+              "incorrect timestep data size for provided volume dimensions");
+        }
+      }
+
+      voxelData = attributes[0];
+    }
+
+    template <int W>
+    inline std::vector<Data *> StructuredVolume<W>::getDataObjects(
+        const Data &data, const std::string &name)
+    {
+      if (data.dataType != VKL_DATA || data.size() == 0) {
+        throw std::runtime_error(name +
+                                 " must be a non-empty array of VKL_DATA");
+      }
+
+      std::vector<Data *> dataObjects(data.begin<Data *>(),
+                                      data.end<Data *>());
+
+      for (const Data *dataObject : dataObjects) {
+        if (!dataObject) {
+          throw std::runtime_error("missing data object in " + name);
+        }
+      }
+
+      return dataObjects;
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::commitGridParameters()
+    {
+      dimensions  = this->template getParam<vec3i>("dimensions", vec3i(128));
+      gridOrigin  = this->template getParam<vec3f>("gridOrigin", vec3f(0.f));
+      gridSpacing = this->template getParam<vec3f>("gridSpacing", vec3f(1.f));
+
+      macrocellWidth = this->template getParam<int>("macrocellWidth", 16);
+
+      if (macrocellWidth < 2 || macrocellWidth > 128 ||
+          (macrocellWidth & (macrocellWidth - 1)) != 0) {
         throw std::runtime_error(
-            "incorrect data size for provided volume dimensions");
+            "macrocellWidth must be a power of two in [2, 128]");
       }
     }
 
@@ -83,7 +266,7 @@ namespace openvkl {
         const vvec3fn<1> &objectCoordinates, vfloatn<1> &samples) const
     {
       CALL_ISPC(SharedStructuredVolume_sample_uniform_export,
-                this->ispcEquivalent,
+                getSamplingEquivalent(),
                 &objectCoordinates,
                 &samples);
     }
@@ -96,7 +279,7 @@ namespace openvkl {
     {
       CALL_ISPC(SharedStructuredVolume_sample_export,
                 static_cast<const int *>(valid),
-                this->ispcEquivalent,
+                getSamplingEquivalent(),
                 &objectCoordinates,
                 &samples);
     }
@@ -109,11 +292,113 @@ namespace openvkl {
     {
       CALL_ISPC(SharedStructuredVolume_gradient_export,
                 static_cast<const int *>(valid),
-                this->ispcEquivalent,
+                getSamplingEquivalent(),
                 &objectCoordinates,
                 &gradients);
     }
 
+    template <int W>
+    inline void StructuredVolume<W>::computeSampleN(
+        unsigned int N,
+        const float *objectCoordinatesX,
+        const float *objectCoordinatesY,
+        const float *objectCoordinatesZ,
+        unsigned int stride,
+        float *samples) const
+    {
+      CALL_ISPC(SharedStructuredVolume_sample_N_export,
+                getSamplingEquivalent(),
+                N,
+                objectCoordinatesX,
+                objectCoordinatesY,
+                objectCoordinatesZ,
+                stride,
+                samples);
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::computeSampleAndGradientN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients) const
+    {
+      CALL_ISPC(SharedStructuredVolume_sample_gradient_N_export,
+                getSamplingEquivalent(),
+                N,
+                (const ispc::vec3f *)objectCoordinates,
+                samples,
+                (ispc::vec3f *)gradients);
+    }
+
+    template <int W>
+    inline unsigned int StructuredVolume<W>::getNumAttributes() const
+    {
+      return std::max(attributes.size(), size_t(1));
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::computeSampleM(
+        const vvec3fn<1> &objectCoordinates,
+        float *samples,
+        unsigned int M,
+        const unsigned int *attributeIndices) const
+    {
+      CALL_ISPC(SharedStructuredVolume_sampleM_uniform_export,
+                getSamplingEquivalent(),
+                &objectCoordinates,
+                M,
+                attributeIndices,
+                samples);
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::computeSampleMN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        unsigned int M,
+        const unsigned int *attributeIndices,
+        size_t samplesStride,
+        float *samples) const
+    {
+      CALL_ISPC(SharedStructuredVolume_sampleM_N_export,
+                getSamplingEquivalent(),
+                N,
+                (const ispc::vec3f *)objectCoordinates,
+                M,
+                attributeIndices,
+                samplesStride,
+                samples);
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::computeSampleAtTime(
+        const vvec3fn<1> &objectCoordinates,
+        float time,
+        vfloatn<1> &sample) const
+    {
+      CALL_ISPC(SharedStructuredVolume_sampleAtTime_uniform_export,
+                getSamplingEquivalent(),
+                &objectCoordinates,
+                time,
+                &sample);
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::computeSampleAtTimeN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        const float *times,
+        float *samples) const
+    {
+      CALL_ISPC(SharedStructuredVolume_sampleAtTime_N_export,
+                getSamplingEquivalent(),
+                N,
+                (const ispc::vec3f *)objectCoordinates,
+                times,
+                samples);
+    }
+
     template <int W>
     inline box3f StructuredVolume<W>::getBoundingBox() const
     {
@@ -131,25 +416,325 @@ namespace openvkl {
     }
 
     template <int W>
-    inline void StructuredVolume<W>::buildAccelerator()
+    inline void StructuredVolume<W>::commitAttributes()
     {
-      void *accelerator = CALL_ISPC(SharedStructuredVolume_createAccelerator,
-                                    this->ispcEquivalent);
+      attributesDataPointers.clear();
+      attributesTypes.clear();
+
+      for (const Data *attribute : attributes) {
+        attributesDataPointers.push_back(attribute->data);
+        attributesTypes.push_back(attribute->dataType);
+      }
+
+      bool success = CALL_ISPC(SharedStructuredVolume_setAttributes,
+                               this->ispcEquivalent,
+                               attributesDataPointers.size(),
+                               attributesDataPointers.data(),
+                               attributesTypes.data());
+
+      if (!success) {
+        throw std::runtime_error(
+            "unsupported attributes for structured volume; multiple "
+            "attributes require the linear layout and trilinear filter");
+      }
+
+      if (timesteps.empty()) {
+        return;
+      }
+
+      timestepsDataPointers.clear();
+      timestepsTypes.clear();
+
+      for (const Data *timestep : timesteps) {
+        timestepsDataPointers.push_back(timestep->data);
+        timestepsTypes.push_back(timestep->dataType);
+      }
 
-      vec3i bricksPerDimension;
-      bricksPerDimension.x =
-          CALL_ISPC(GridAccelerator_getBricksPerDimension_x, accelerator);
-      bricksPerDimension.y =
-          CALL_ISPC(GridAccelerator_getBricksPerDimension_y, accelerator);
-      bricksPerDimension.z =
-          CALL_ISPC(GridAccelerator_getBricksPerDimension_z, accelerator);
+      success = CALL_ISPC(SharedStructuredVolume_setTimesteps,
+                          this->ispcEquivalent,
+                          timestepsDataPointers.size(),
+                          timestepsDataPointers.data(),
+                          timestepsTypes.data());
+
+      if (!success) {
+        throw std::runtime_error(
+            "unsupported timesteps for structured volume; timesteps must "
+            "have the same voxel type, and require the linear layout and "
+            "trilinear filter");
+      }
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::buildAccelerator(const char *cacheType)
+    {
+      accelerator = CALL_ISPC(SharedStructuredVolume_createAccelerator,
+                              this->ispcEquivalent,
+                              macrocellWidth);
+
+      const std::string cacheFilename =
+          cacheType ? this->template getParam<std::string>(
+                          "acceleratorCacheFile", "")
+                    : "";
+
+      AcceleratorCacheKey cacheKey;
+
+      if (!cacheFilename.empty()) {
+        cacheKey = getAcceleratorCacheKey(cacheType);
+
+        if (loadAccelerator(cacheFilename, cacheKey)) {
+          return;
+        }
+      }
+
+      // macrocells are built one z-slab per task, each streaming through the
+      // voxels it depends on once; the volume value range is reduced from the
+      // value ranges of all slabs
+      const int numTasks = CALL_ISPC(
+          GridAccelerator_getLevelCellsPerDimension_z, accelerator, 0);
+
+      std::vector<range1f> slabValueRanges(numTasks);
 
-      const int numTasks =
-          bricksPerDimension.x * bricksPerDimension.y * bricksPerDimension.z;
       tasking::parallel_for(numTasks, [&](int taskIndex) {
-        CALL_ISPC(GridAccelerator_build, accelerator, taskIndex);
+        CALL_ISPC(GridAccelerator_build,
+                  accelerator,
+                  taskIndex,
+                  slabValueRanges[taskIndex].lower,
+                  slabValueRanges[taskIndex].upper);
       });
 
+      // coarse levels of the value range hierarchy are built from the next
+      // finer level, one z-slice of cells per task
+      const int numLevels =
+          CALL_ISPC(GridAccelerator_getNumLevels, accelerator);
+
+      for (int level = 1; level < numLevels; level++) {
+        const int numLevelTasks = CALL_ISPC(
+            GridAccelerator_getLevelCellsPerDimension_z, accelerator, level);
+
+        tasking::parallel_for(numLevelTasks, [&](int taskIndex) {
+          CALL_ISPC(GridAccelerator_buildLevel, accelerator, level, taskIndex);
+        });
+      }
+
+      valueRange = empty;
+
+      for (const range1f &slabValueRange : slabValueRanges) {
+        valueRange.lower = std::min(valueRange.lower, slabValueRange.lower);
+        valueRange.upper = std::max(valueRange.upper, slabValueRange.upper);
+      }
+
+      if (!cacheFilename.empty()) {
+        storeAccelerator(cacheFilename, cacheKey);
+      }
+    }
+
+    template <int W>
+    inline AcceleratorCacheKey StructuredVolume<W>::getAcceleratorCacheKey(
+        const char *cacheType)
+    {
+      AcceleratorCacheKey key;
+
+      key.addString(cacheType);
+      key.add(dimensions);
+      key.add(macrocellWidth);
+      key.add(this->template getParam<int>("filter", VKL_FILTER_TRILINEAR));
+
+      // the acceleration structure only depends on the first attribute, but
+      // on all timesteps
+      key.addData(voxelData);
+      key.add(timesteps.size());
+
+      for (size_t i = 1; i < timesteps.size(); i++) {
+        key.addData(timesteps[i]);
+      }
+
+      return key;
+    }
+
+    template <int W>
+    inline bool StructuredVolume<W>::loadAccelerator(
+        const std::string &cacheFilename, const AcceleratorCacheKey &cacheKey)
+    {
+      std::vector<std::vector<char>> blocks;
+
+      if (!loadAcceleratorCache(cacheFilename, cacheKey, blocks)) {
+        return false;
+      }
+
+      // one block per level of the value range hierarchy, and the volume
+      // value range
+      const int numLevels =
+          CALL_ISPC(GridAccelerator_getNumLevels, accelerator);
+
+      if (blocks.size() != size_t(numLevels) + 1 ||
+          blocks[numLevels].size() != sizeof(range1f)) {
+        return false;
+      }
+
+      for (int level = 0; level < numLevels; level++) {
+        uint64_t numCells = 0;
+        CALL_ISPC(
+            GridAccelerator_getLevelValueRanges, accelerator, level, numCells);
+
+        if (blocks[level].size() != numCells * sizeof(range1f)) {
+          return false;
+        }
+      }
+
+      for (int level = 0; level < numLevels; level++) {
+        uint64_t numCells = 0;
+        void *levelValueRanges = CALL_ISPC(
+            GridAccelerator_getLevelValueRanges, accelerator, level, numCells);
+
+        std::memcpy(
+            levelValueRanges, blocks[level].data(), blocks[level].size());
+      }
+
+      std::memcpy(&valueRange, blocks[numLevels].data(), sizeof(range1f));
+
+      return true;
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::storeAccelerator(
+        const std::string &cacheFilename,
+        const AcceleratorCacheKey &cacheKey) const
+    {
+      std::vector<AcceleratorCacheBlock> blocks;
+
+      const int numLevels =
+          CALL_ISPC(GridAccelerator_getNumLevels, accelerator);
+
+      for (int level = 0; level < numLevels; level++) {
+        uint64_t numCells = 0;
+        const void *levelValueRanges = CALL_ISPC(
+            GridAccelerator_getLevelValueRanges, accelerator, level, numCells);
+
+        blocks.push_back({levelValueRanges, numCells * sizeof(range1f)});
+      }
+
+      blocks.push_back({&valueRange, sizeof(range1f)});
+
+      storeAcceleratorCache(cacheFilename, cacheKey, blocks);
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::buildReplicas(const void *voxels,
+                                                   size_t numBytes)
+    {
+      releaseReplicas();
+
+      const bool numaReplicas =
+          this->template getParam<int>("numaReplicas", 0);
+
+      if (!numaReplicas || getNumNumaNodes() == 1) {
+        return;
+      }
+
+      if (attributes.size() > 1 || timesteps.size() > 1) {
+        throw std::runtime_error(
+            "numaReplicas requires a single attribute and timestep");
+      }
+
+      voxelReplicaSize = numBytes;
+
+      for (int node = 0; node < getNumNumaNodes(); node++) {
+        char *replica = static_cast<char *>(numaAlloc(numBytes, node));
+
+        if (!replica) {
+          releaseReplicas();
+          throw std::runtime_error("could not allocate NUMA replica");
+        }
+
+        voxelReplicas.push_back(replica);
+
+        // pages are placed on the node regardless of the copying thread
+        const size_t chunkSize = size_t(1) << 24;
+        const size_t numChunks = (numBytes + chunkSize - 1) / chunkSize;
+
+        tasking::parallel_for(numChunks, [&](size_t chunkIndex) {
+          const size_t offset = chunkIndex * chunkSize;
+          std::memcpy(replica + offset,
+                      static_cast<const char *>(voxels) + offset,
+                      std::min(chunkSize, numBytes - offset));
+        });
+
+        ispcReplicas.push_back(CALL_ISPC(SharedStructuredVolume_createReplica,
+                                         this->ispcEquivalent,
+                                         replica));
+      }
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::releaseReplicas()
+    {
+      for (void *ispcReplica : ispcReplicas) {
+        CALL_ISPC(SharedStructuredVolume_destroyReplica, ispcReplica);
+      }
+
+      for (void *voxelReplica : voxelReplicas) {
+        numaFree(voxelReplica, voxelReplicaSize);
+      }
+
+      ispcReplicas.clear();
+      voxelReplicas.clear();
+      voxelReplicaSize = 0;
+    }
+
+    template <int W>
+    inline void *StructuredVolume<W>::getSamplingEquivalent() const
+    {
+      if (ispcReplicas.empty()) {
+        return this->ispcEquivalent;
+      }
+
+      return ispcReplicas[getCurrentNumaNode()];
+    }
+
+    template <int W>
+    inline void StructuredVolume<W>::invalidateRegion(const box3i &region)
+    {
+      if (!accelerator) {
+        throw std::runtime_error(
+            "volume must be committed before invalidating regions");
+      }
+
+      // replicas do not reflect modifications of the voxel data set on the
+      // volume
+      if (!ispcReplicas.empty()) {
+        throw std::runtime_error(
+            "invalidateRegion() is not supported with numaReplicas; recommit "
+            "the volume instead");
+      }
+
+      vec3i cellLower;
+      vec3i cellUpper;
+
+      const bool overlaps = CALL_ISPC(GridAccelerator_getCellRange,
+                                      accelerator,
+                                      (const ispc::vec3i &)region.lower,
+                                      (const ispc::vec3i &)region.upper,
+                                      (ispc::vec3i &)cellLower,
+                                      (ispc::vec3i &)cellUpper);
+
+      if (!overlaps) {
+        return;
+      }
+
+      const int numTasks = cellUpper.z - cellLower.z + 1;
+      tasking::parallel_for(numTasks, [&](int taskIndex) {
+        CALL_ISPC(GridAccelerator_buildCells,
+                  accelerator,
+                  (const ispc::vec3i &)cellLower,
+                  (const ispc::vec3i &)cellUpper,
+                  cellLower.z + taskIndex);
+      });
+
+      CALL_ISPC(GridAccelerator_buildLevelsRegion,
+                accelerator,
+                (const ispc::vec3i &)cellLower,
+                (const ispc::vec3i &)cellUpper);
+
       CALL_ISPC(GridAccelerator_computeValueRange,
                 accelerator,
                 valueRange.lower,
@@ -2,8 +2,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "UnstructuredVolume.h"
+#include <cstring>
 #include "../common/Data.h"
-#include "ospcommon/containers/AlignedVector.h"
 #include "ospcommon/tasking/parallel_for.h"
 
 // Map cell type to its vertices count
@@ -47,13 +47,15 @@ namespace openvkl {
         std::cerr << "range: " << inner->valueRange
                   << " nom: " << inner->nominalLength << std::endl;
 
-        tabIndent(indent);
-        std::cerr << "bounds[0]: " << inner->bounds[0] << std::endl;
-        dumpBVH(inner->children[0], indent + 1);
+        for (int i = 0; i < InnerNode::maxChildren; i++) {
+          if (!inner->children[i])
+            continue;
 
-        tabIndent(indent);
-        std::cerr << "bounds[1]: " << inner->bounds[1] << std::endl;
-        dumpBVH(inner->children[1], indent + 1);
+          tabIndent(indent);
+          std::cerr << "bounds[" << i << "]: " << inner->getChildBounds(i)
+                    << std::endl;
+          dumpBVH(inner->children[i], indent + 1);
+        }
       }
     }
 
@@ -258,11 +260,50 @@ namespace openvkl {
     template <int W>
     void UnstructuredVolume<W>::buildBvhAndCalculateBounds()
     {
-      rtcDevice = rtcNewDevice(NULL);
+      const std::string cacheFilename =
+          this->template getParam<std::string>("acceleratorCacheFile", "");
+
+      AcceleratorCacheKey cacheKey;
+
+      if (!cacheFilename.empty()) {
+        cacheKey = getBvhCacheKey();
+      }
+
+      if (cacheFilename.empty() || !loadBvh(cacheFilename, cacheKey)) {
+        buildBvh();
+
+        if (!cacheFilename.empty()) {
+          storeBvh(cacheFilename, cacheKey);
+        }
+      }
+
+      if (rtcRoot->nominalLength < 0) {
+        auto &val = ((LeafNode *)rtcRoot)->bounds;
+        bounds    = box3f(val.lower, val.upper);
+      } else {
+        bounds = ((InnerNode *)rtcRoot)->getBounds();
+      }
+      valueRange = rtcRoot->valueRange;
+    }
+
+    template <int W>
+    void UnstructuredVolume<W>::buildBvh()
+    {
+      if (rtcBVH) {
+        rtcReleaseBVH(rtcBVH);
+        rtcBVH = nullptr;
+      }
+
+      cachedInnerNodes.clear();
+      cachedLeafNodes.clear();
+
       if (!rtcDevice) {
-        throw std::runtime_error("cannot create device");
+        rtcDevice = rtcNewDevice(NULL);
+        if (!rtcDevice) {
+          throw std::runtime_error("cannot create device");
+        }
+        rtcSetDeviceErrorFunction(rtcDevice, errorFunction, NULL);
       }
-      rtcSetDeviceErrorFunction(rtcDevice, errorFunction, NULL);
 
       containers::AlignedVector<RTCBuildPrimitive> prims;
       containers::AlignedVector<range1f> range;
@@ -291,7 +332,7 @@ namespace openvkl {
       arguments.byteSize               = sizeof(arguments);
       arguments.buildFlags             = RTC_BUILD_FLAG_NONE;
       arguments.buildQuality           = RTC_BUILD_QUALITY_MEDIUM;
-      arguments.maxBranchingFactor     = 2;
+      arguments.maxBranchingFactor     = InnerNode::maxChildren;
       arguments.maxDepth               = 1024;
       arguments.sahBlockSize           = 1;
       arguments.minLeafSize            = 1;
@@ -314,16 +355,137 @@ namespace openvkl {
       if (!rtcRoot) {
         throw std::runtime_error("bvh build failure");
       }
+    }
 
-      if (rtcRoot->nominalLength < 0) {
-        auto &val = ((LeafNode *)rtcRoot)->bounds;
-        bounds    = box3f(val.lower, val.upper);
-      } else {
-        auto &vals = ((InnerNode *)rtcRoot)->bounds;
-        bounds     = box3f(vals[0].lower, vals[0].upper);
-        bounds.extend(box3f(vals[1].lower, vals[1].upper));
+    template <int W>
+    AcceleratorCacheKey UnstructuredVolume<W>::getBvhCacheKey() const
+    {
+      AcceleratorCacheKey key;
+
+      key.addString("unstructured");
+      key.add(sizeof(InnerNode));
+      key.add(sizeof(LeafNode));
+
+      key.addData(vertexPosition);
+      key.addData(vertexValue);
+      key.addData(index);
+      key.add(indexPrefixed);
+      key.addData(cellIndex);
+      key.addData(cellValue);
+      key.addData(cellType);
+
+      return key;
+    }
+
+    template <int W>
+    bool UnstructuredVolume<W>::loadBvh(const std::string &cacheFilename,
+                                        const AcceleratorCacheKey &cacheKey)
+    {
+      std::vector<std::vector<char>> blocks;
+
+      if (!loadAcceleratorCache(cacheFilename, cacheKey, blocks)) {
+        return false;
       }
-      valueRange = rtcRoot->valueRange;
+
+      // inner nodes and leaf nodes; the root is the first inner node, or the
+      // only leaf node
+      if (blocks.size() != 2 || blocks[0].size() % sizeof(InnerNode) ||
+          blocks[1].size() % sizeof(LeafNode)) {
+        return false;
+      }
+
+      const size_t numInnerNodes = blocks[0].size() / sizeof(InnerNode);
+      const size_t numLeafNodes  = blocks[1].size() / sizeof(LeafNode);
+
+      if (numLeafNodes == 0 || (numInnerNodes == 0 && numLeafNodes != 1)) {
+        return false;
+      }
+
+      containers::AlignedVector<InnerNode> innerNodes(numInnerNodes);
+      containers::AlignedVector<LeafNode> leafNodes(numLeafNodes);
+
+      std::memcpy(innerNodes.data(), blocks[0].data(), blocks[0].size());
+      std::memcpy(leafNodes.data(), blocks[1].data(), blocks[1].size());
+
+      for (InnerNode &innerNode : innerNodes) {
+        for (Node *&child : innerNode.children) {
+          const uintptr_t reference = reinterpret_cast<uintptr_t>(child);
+
+          if (reference == 0) {
+            continue;
+          }
+
+          const size_t nodeIndex = (reference >> 1) - 1;
+
+          if (reference & 1) {
+            if (nodeIndex >= numLeafNodes) {
+              return false;
+            }
+            child = &leafNodes[nodeIndex];
+          } else {
+            if (nodeIndex >= numInnerNodes) {
+              return false;
+            }
+            child = &innerNodes[nodeIndex];
+          }
+        }
+      }
+
+      if (rtcBVH) {
+        rtcReleaseBVH(rtcBVH);
+        rtcBVH = nullptr;
+      }
+
+      // swapping keeps the node addresses
+      cachedInnerNodes.swap(innerNodes);
+      cachedLeafNodes.swap(leafNodes);
+
+      rtcRoot = numInnerNodes ? static_cast<Node *>(&cachedInnerNodes[0])
+                              : static_cast<Node *>(&cachedLeafNodes[0]);
+
+      return true;
+    }
+
+    template <int W>
+    void UnstructuredVolume<W>::storeBvh(
+        const std::string &cacheFilename,
+        const AcceleratorCacheKey &cacheKey) const
+    {
+      containers::AlignedVector<InnerNode> innerNodes;
+      containers::AlignedVector<LeafNode> leafNodes;
+
+      // copies the node, returning its index plus one (zero denotes unused
+      // children) tagged in the lowest bit for leaf nodes
+      auto addNode = [&](const Node *node) -> uintptr_t {
+        if (!node) {
+          return 0;
+        }
+
+        if (node->nominalLength < 0) {
+          leafNodes.push_back(*static_cast<const LeafNode *>(node));
+          return (uintptr_t(leafNodes.size()) << 1) | 1;
+        }
+
+        innerNodes.push_back(*static_cast<const InnerNode *>(node));
+        return uintptr_t(innerNodes.size()) << 1;
+      };
+
+      addNode(rtcRoot);
+
+      // inner nodes are copied in breadth-first order, replacing the child
+      // pointers of each node as it is visited
+      for (size_t i = 0; i < innerNodes.size(); i++) {
+        for (int c = 0; c < InnerNode::maxChildren; c++) {
+          const uintptr_t reference = addNode(innerNodes[i].children[c]);
+          innerNodes[i].children[c] = reinterpret_cast<Node *>(reference);
+        }
+      }
+
+      storeAcceleratorCache(
+          cacheFilename,
+          cacheKey,
+          {{innerNodes.data(), innerNodes.size() * sizeof(InnerNode)},
+           {leafNodes.data(), leafNodes.size() * sizeof(LeafNode)}});
     }
 
     template <int W>
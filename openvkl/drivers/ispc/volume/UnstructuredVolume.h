@@ -7,9 +7,11 @@
 #include "../common/export_util.h"
 #include "../common/math.h"
 #include "../iterator/UnstructuredIterator.h"
+#include "AcceleratorCache.h"
 #include "UnstructuredVolume_ispc.h"
 #include "Volume.h"
 #include "embree3/rtcore.h"
+#include "ospcommon/containers/AlignedVector.h"
 
 namespace openvkl {
   namespace ispc_driver {
@@ -27,6 +29,8 @@ namespace openvkl {
       box3fa bounds;
       uint64_t cellID;
 
+      LeafNode() = default;
+
       LeafNode(unsigned id, const box3fa &bounds, const range1f &range)
           : cellID(id), bounds(bounds)
       {
@@ -51,21 +55,60 @@ namespace openvkl {
 
     struct InnerNode : public Node
     {
-      // 18 + 16 + 2 * 4 * 6 = 82 bytes
-      box3fa bounds[2];
-      Node *children[2];
+      // must match UNSTRUCTURED_BVH_WIDTH
+      static constexpr int maxChildren = 4;
+
+      // 12 + 6 * 4 * 4 + 4 * 8 = 140 bytes, plus padding. child bounds are
+      // stored in SoA layout; unused children have empty bounds and null
+      // pointers.
+      float lowerX[maxChildren];
+      float lowerY[maxChildren];
+      float lowerZ[maxChildren];
+      float upperX[maxChildren];
+      float upperY[maxChildren];
+      float upperZ[maxChildren];
+      Node *children[maxChildren];
 
       InnerNode()
       {
-        children[0] = children[1] = nullptr;
-        bounds[0] = bounds[1] = empty;
+        for (int i = 0; i < maxChildren; i++) {
+          children[i] = nullptr;
+          setChildBounds(i, empty);
+        }
+      }
+
+      box3f getChildBounds(int i) const
+      {
+        return box3f(vec3f(lowerX[i], lowerY[i], lowerZ[i]),
+                     vec3f(upperX[i], upperY[i], upperZ[i]));
+      }
+
+      void setChildBounds(int i, const box3f &bounds)
+      {
+        lowerX[i] = bounds.lower.x;
+        lowerY[i] = bounds.lower.y;
+        lowerZ[i] = bounds.lower.z;
+        upperX[i] = bounds.upper.x;
+        upperY[i] = bounds.upper.y;
+        upperZ[i] = bounds.upper.z;
+      }
+
+      // union of the bounds of all children
+      box3f getBounds() const
+      {
+        box3f bounds = empty;
+        for (int i = 0; i < maxChildren; i++) {
+          if (children[i])
+            bounds.extend(getChildBounds(i));
+        }
+        return bounds;
       }
 
       static void *create(RTCThreadLocalAllocator alloc,
                           unsigned int numChildren,
                           void *userPtr)
       {
-        assert(numChildren == 2);
+        assert(numChildren <= maxChildren);
         void *ptr = rtcThreadLocalAlloc(alloc, sizeof(InnerNode), 16);
         return (void *)new (ptr) InnerNode;
       }
@@ -75,15 +118,18 @@ namespace openvkl {
                               unsigned int numChildren,
                               void *userPtr)
       {
-        assert(numChildren == 2);
+        assert(numChildren <= maxChildren);
         auto innerNode = (InnerNode *)nodePtr;
-        for (size_t i = 0; i < 2; i++)
+        for (size_t i = 0; i < numChildren; i++)
           innerNode->children[i] = (Node *)childPtr[i];
-        innerNode->nominalLength =
-            min(fabs(innerNode->children[0]->nominalLength),
-                fabs(innerNode->children[1]->nominalLength));
-        innerNode->valueRange = innerNode->children[0]->valueRange;
-        innerNode->valueRange.extend(innerNode->children[1]->valueRange);
+        innerNode->nominalLength = fabs(innerNode->children[0]->nominalLength);
+        innerNode->valueRange    = innerNode->children[0]->valueRange;
+        for (size_t i = 1; i < numChildren; i++) {
+          innerNode->nominalLength =
+              min(innerNode->nominalLength,
+                  fabs(innerNode->children[i]->nominalLength));
+          innerNode->valueRange.extend(innerNode->children[i]->valueRange);
+        }
       }
 
       static void setBounds(void *nodePtr,
@@ -91,9 +137,12 @@ namespace openvkl {
                             unsigned int numChildren,
                             void *userPtr)
       {
-        assert(numChildren == 2);
-        for (size_t i = 0; i < 2; i++)
-          ((InnerNode *)nodePtr)->bounds[i] = *(const box3fa *)bounds[i];
+        assert(numChildren <= maxChildren);
+        for (size_t i = 0; i < numChildren; i++) {
+          const box3fa &childBounds = *(const box3fa *)bounds[i];
+          ((InnerNode *)nodePtr)
+              ->setChildBounds(i, box3f(childBounds.lower, childBounds.upper));
+        }
       }
     };
 
@@ -137,8 +186,22 @@ namespace openvkl {
       }
 
      private:
+      // uses the BVH of the acceleratorCacheFile parameter, if set and
+      // matching the current inputs; builds (and caches) the BVH otherwise
       void buildBvhAndCalculateBounds();
 
+      void buildBvh();
+
+      AcceleratorCacheKey getBvhCacheKey() const;
+
+      // BVHs are cached with child pointers replaced by node indices; returns
+      // false if the cache does not match the current inputs
+      bool loadBvh(const std::string &cacheFilename,
+                   const AcceleratorCacheKey &cacheKey);
+
+      void storeBvh(const std::string &cacheFilename,
+                    const AcceleratorCacheKey &cacheKey) const;
+
       // Read 32/64-bit integer value from given array
       uint64_t readInteger(const void *array, bool is32Bit, uint64_t id) const;
 
@@ -181,6 +244,10 @@ namespace openvkl {
       RTCBVH rtcBVH{0};
       RTCDevice rtcDevice{0};
       Node *rtcRoot{nullptr};
+
+      // nodes of a BVH loaded from a cache, instead of rtcBVH
+      containers::AlignedVector<InnerNode> cachedInnerNodes;
+      containers::AlignedVector<LeafNode> cachedLeafNodes;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -123,10 +123,85 @@ namespace openvkl {
                                     const vvec3fn<W> &objectCoordinates,
                                     vvec3fn<W> &gradients) const;
 
+      // sample a stream of N coordinates, given as separate x, y and z arrays
+      // with the given stride (in floats) between consecutive coordinates. the
+      // default implementation gathers coordinates into packets of width W and
+      // uses computeSampleV()
+      virtual void computeSampleN(unsigned int N,
+                                  const float *objectCoordinatesX,
+                                  const float *objectCoordinatesY,
+                                  const float *objectCoordinatesZ,
+                                  unsigned int stride,
+                                  float *samples) const;
+
+      // sample values and gradients for a stream of N coordinates. the default
+      // implementation uses computeSampleV() and computeGradientV() on packets
+      // of width W; volumes should override this if the sample value can be
+      // reused in the gradient computation
+      virtual void computeSampleAndGradientN(
+          unsigned int N,
+          const vvec3fn<1> *objectCoordinates,
+          float *samples,
+          vvec3fn<1> *gradients) const;
+
+      // number of attributes that can be sampled with computeSampleM();
+      // attribute 0 is the one sampled by all other methods
+      virtual unsigned int getNumAttributes() const;
+
+      // sample the M attributes with the given indices at a single coordinate.
+      // the default implementation supports volumes with a single attribute
+      // only, and uses computeSample()
+      virtual void computeSampleM(const vvec3fn<1> &objectCoordinates,
+                                  float *samples,
+                                  unsigned int M,
+                                  const unsigned int *attributeIndices) const;
+
+      // sample the M attributes with the given indices for a stream of N
+      // coordinates; the sample of attribute i at coordinate j is written to
+      // samples[i * samplesStride + j]. the default implementation supports
+      // volumes with a single attribute only, and uses computeSampleN()
+      virtual void computeSampleMN(unsigned int N,
+                                   const vvec3fn<1> *objectCoordinates,
+                                   unsigned int M,
+                                   const unsigned int *attributeIndices,
+                                   size_t samplesStride,
+                                   float *samples) const;
+
+      // sample at a single coordinate and the given time in [0, 1]. the
+      // default implementation is for volumes which do not vary over time,
+      // and uses computeSample()
+      virtual void computeSampleAtTime(const vvec3fn<1> &objectCoordinates,
+                                       float time,
+                                       vfloatn<1> &sample) const;
+
+      // sample a stream of N coordinates, each at its own time. the default
+      // implementation ignores the times, and uses computeSampleN()
+      virtual void computeSampleAtTimeN(unsigned int N,
+                                        const vvec3fn<1> *objectCoordinates,
+                                        const float *times,
+                                        float *samples) const;
+
+      // initialize the internal state of an accessor for this volume. the
+      // default implementation is for volumes which do not use accessors
+      virtual void initAccessor(VKLAccessor &accessor) const;
+
+      // sample at a single coordinate, using and updating the given accessor.
+      // the default implementation ignores the accessor, and uses
+      // computeSample()
+      virtual void computeSampleWithAccessor(
+          VKLAccessor &accessor,
+          const vvec3fn<1> &objectCoordinates,
+          vfloatn<1> &sample) const;
+
       virtual box3f getBoundingBox() const = 0;
 
       virtual range1f getValueRange() const = 0;
 
+      // updates acceleration structures and the value range of a committed
+      // volume for the given (inclusive) region of voxel indices, after its
+      // voxel data was modified in place
+      virtual void invalidateRegion(const box3i &region);
+
       void *getISPCEquivalent() const;
 
       virtual VKLObserver newObserver(const char *type)
@@ -325,6 +400,162 @@ namespace openvkl {
       sample[0] = samplesW[0];
     }
 
+    template <int W>
+    inline void Volume<W>::computeSampleN(unsigned int N,
+                                          const float *objectCoordinatesX,
+                                          const float *objectCoordinatesY,
+                                          const float *objectCoordinatesZ,
+                                          unsigned int stride,
+                                          float *samples) const
+    {
+      for (unsigned int packBegin = 0; packBegin < N; packBegin += W) {
+        const unsigned int packSize = std::min(N - packBegin, (unsigned int)W);
+
+        vvec3fn<W> ocW;
+        vintn<W> validW;
+
+        for (unsigned int i = 0; i < W; i++) {
+          // inactive lanes replicate the first coordinate of the packet
+          const size_t ofs =
+              size_t(packBegin + (i < packSize ? i : 0)) * stride;
+
+          ocW.x[i]  = objectCoordinatesX[ofs];
+          ocW.y[i]  = objectCoordinatesY[ofs];
+          ocW.z[i]  = objectCoordinatesZ[ofs];
+          validW[i] = i < packSize ? -1 : 0;
+        }
+
+        vfloatn<W> samplesW;
+
+        computeSampleV(validW, ocW, samplesW);
+
+        for (unsigned int i = 0; i < packSize; i++)
+          samples[packBegin + i] = samplesW[i];
+      }
+    }
+
+    template <int W>
+    inline unsigned int Volume<W>::getNumAttributes() const
+    {
+      return 1;
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleM(
+        const vvec3fn<1> &objectCoordinates,
+        float *samples,
+        unsigned int M,
+        const unsigned int *attributeIndices) const
+    {
+      // all attribute indices are zero
+      vfloatn<1> sample;
+      computeSample(objectCoordinates, sample);
+
+      for (unsigned int i = 0; i < M; i++)
+        samples[i] = sample[0];
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleMN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        unsigned int M,
+        const unsigned int *attributeIndices,
+        size_t samplesStride,
+        float *samples) const
+    {
+      if (M == 0)
+        return;
+
+      // all attribute indices are zero
+      computeSampleN(N,
+                     &objectCoordinates[0].x[0],
+                     &objectCoordinates[0].y[0],
+                     &objectCoordinates[0].z[0],
+                     3,
+                     samples);
+
+      for (unsigned int i = 1; i < M; i++)
+        std::copy(samples, samples + N, samples + i * samplesStride);
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleAtTime(
+        const vvec3fn<1> &objectCoordinates,
+        float time,
+        vfloatn<1> &sample) const
+    {
+      computeSample(objectCoordinates, sample);
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleAtTimeN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        const float *times,
+        float *samples) const
+    {
+      computeSampleN(N,
+                     &objectCoordinates[0].x[0],
+                     &objectCoordinates[0].y[0],
+                     &objectCoordinates[0].z[0],
+                     3,
+                     samples);
+    }
+
+    template <int W>
+    inline void Volume<W>::initAccessor(VKLAccessor &accessor) const
+    {
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleWithAccessor(
+        VKLAccessor &accessor,
+        const vvec3fn<1> &objectCoordinates,
+        vfloatn<1> &sample) const
+    {
+      computeSample(objectCoordinates, sample);
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleAndGradientN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients) const
+    {
+      for (unsigned int packBegin = 0; packBegin < N; packBegin += W) {
+        const unsigned int packSize = std::min(N - packBegin, (unsigned int)W);
+
+        vvec3fn<W> ocW;
+        vintn<W> validW;
+
+        for (unsigned int i = 0; i < W; i++) {
+          // inactive lanes replicate the first coordinate of the packet
+          const vvec3fn<1> &oc =
+              objectCoordinates[packBegin + (i < packSize ? i : 0)];
+
+          ocW.x[i]  = oc.x[0];
+          ocW.y[i]  = oc.y[0];
+          ocW.z[i]  = oc.z[0];
+          validW[i] = i < packSize ? -1 : 0;
+        }
+
+        vfloatn<W> samplesW;
+        vvec3fn<W> gradientsW;
+
+        computeSampleV(validW, ocW, samplesW);
+        computeGradientV(validW, ocW, gradientsW);
+
+        for (unsigned int i = 0; i < packSize; i++) {
+          samples[packBegin + i]        = samplesW[i];
+          gradients[packBegin + i].x[0] = gradientsW.x[i];
+          gradients[packBegin + i].y[0] = gradientsW.y[i];
+          gradients[packBegin + i].z[0] = gradientsW.z[i];
+        }
+      }
+    }
+
     template <int W>
     inline void Volume<W>::computeGradientV(const vintn<W> &valid,
                                             const vvec3fn<W> &objectCoordinates,
@@ -333,6 +564,12 @@ namespace openvkl {
       THROW_NOT_IMPLEMENTED;
     }
 
+    template <int W>
+    inline void Volume<W>::invalidateRegion(const box3i &region)
+    {
+      THROW_NOT_IMPLEMENTED;
+    }
+
     template <int W>
     inline void *Volume<W>::getISPCEquivalent() const
     {
@@ -21,6 +21,29 @@ namespace openvkl {
 
 #endif  // defined(__cplusplus)
 
+/*
+ * Leaf pointer voxels store the encoding of the leaf data. There are only two
+ * bits available for this (see vklVdbVoxelMakeLeafPtr), so the encoding is
+ * separate from VKLVdbLeafFormat.
+ */
+enum VdbLeafEncoding
+{
+  VDB_LEAF_ENCODING_FLOAT  = 0,
+  VDB_LEAF_ENCODING_HALF   = 1,
+  VDB_LEAF_ENCODING_UCHAR  = 2,  // Quantized, see VdbLeafQuantization.
+  VDB_LEAF_ENCODING_USHORT = 3   // Quantized, see VdbLeafQuantization.
+};
+
+/*
+ * Quantized leaves store values q, which are reconstructed as
+ * offset + scale * q.
+ */
+struct VdbLeafQuantization
+{
+  float scale;
+  float offset;
+};
+
 struct VdbLevel
 {
   vkl_uint64 numNodes;
@@ -34,6 +57,11 @@ struct VdbLevel
 
   // For each voxel, the range of values contained within.
   range1f *valueRange;
+
+  // For each voxel, the quantization of quantized leaves.
+  // Note: This is only allocated if the grid contains quantized leaves, and
+  //       only valid for quantized leaf voxels.
+  VdbLeafQuantization *leafQuantization;
 };
 
 /*
@@ -57,9 +85,28 @@ struct VdbGrid
   vec3i rootOrigin;           // In index space.
   vkl_uint32
       *usageBuffer;  // Nonzero if the given input leaf has been accessed.
+  vkl_uint64 commitGeneration;  // Unique for every commit of any volume.
   VdbLevel levels[VKL_VDB_NUM_LEVELS - 1];
 };
 
+/*
+ * The internal state of accessors (see VKLAccessor) for vdb volumes.
+ * Caches the inner nodes visited by the most recent sample: for each level
+ * up to depth, the node index and its origin (a domain offset). The node on
+ * each level is a child of the node on the previous level; level 0 is the
+ * root node.
+ * A recommit may allocate its grid at the same address as the previous one,
+ * so the cached nodes are only valid if the commit generation matches, too.
+ */
+struct VdbAccessor
+{
+  const VdbGrid *grid;          // The grid that the cached nodes belong to.
+  vkl_uint64 commitGeneration;  // The commit generation of that grid.
+  vkl_uint32 depth;
+  vec3ui nodeOrigin[VKL_VDB_NUM_LEVELS - 1];
+  vkl_uint64 nodeIndex[VKL_VDB_NUM_LEVELS - 1];
+};
+
 /*
  * Transform points and vectors with the given affine matrix (in row major
  * order).
@@ -171,13 +218,13 @@ __vkl_interop_univary(__vkl_vdb_xfm_functions)
   }                                                                            \
                                                                                \
   inline univary vkl_uint64 vklVdbVoxelMakeLeafPtr(                            \
-      const void *univary leafPtr, univary VKLVdbLeafFormat format)            \
+      const void *univary leafPtr, univary VdbLeafEncoding encoding)           \
   {                                                                            \
     const univary vkl_uint64 intptr = ((univary vkl_uint64)leafPtr);           \
     assert((intptr & 0xFu) == 0); /* Require 16 Byte alignment! */             \
     const univary vkl_uint64 voxel =                                           \
         (intptr & ~((univary vkl_uint64)0xFu)) +                               \
-        ((((univary vkl_uint64)format) & 0x3u) << 2) + 0x3u;                   \
+        ((((univary vkl_uint64)encoding) & 0x3u) << 2) + 0x3u;                 \
     assert((const void *univary)(voxel & ~((univary vkl_uint64)0xFu)) ==       \
            leafPtr);                                                           \
     return voxel;                                                              \
@@ -188,10 +235,10 @@ __vkl_interop_univary(__vkl_vdb_xfm_functions)
     return ((voxel & 0x3u) == 0x3u);                                           \
   }                                                                            \
                                                                                \
-  inline univary VKLVdbLeafFormat vklVdbVoxelLeafGetFormat(                    \
+  inline univary VdbLeafEncoding vklVdbVoxelLeafGetEncoding(                   \
       univary vkl_uint32 voxel)                                                \
   {                                                                            \
-    return ((VKLVdbLeafFormat)((voxel >> 2) & 0x3u));                          \
+    return ((VdbLeafEncoding)((voxel >> 2) & 0x3u));                           \
   }                                                                            \
   /* Leaf pointers are always 64 bit */                                        \
   inline const void *univary vklVdbVoxelLeafGetPtr(univary vkl_uint64 voxel)   \
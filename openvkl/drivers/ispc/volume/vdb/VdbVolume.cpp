@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "VdbVolume.h"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include "../../common/export_util.h"
 #include "../common/logging.h"
@@ -11,10 +13,18 @@
 #include "ospcommon/math/AffineSpace.h"
 #include "ospcommon/memory/malloc.h"
 #include "ospcommon/tasking/AsyncTask.h"
+#include "ospcommon/tasking/parallel_for.h"
 
 namespace openvkl {
   namespace ispc_driver {
 
+    /*
+     * Distinguishes grids of different commits, even if a grid is allocated
+     * at the address of a previously freed one. Accessors use this to detect
+     * stale cached nodes.
+     */
+    static std::atomic<vkl_uint64> nextCommitGeneration{1};
+
     /*
      * Centralized allocation helpers.
      */
@@ -88,6 +98,7 @@ namespace openvkl {
           deallocate(level.voxels);
           deallocate(level.valueRange);
           deallocate(level.leafIndex);
+          deallocate(level.leafQuantization);
         }
         deallocate(grid->usageBuffer);
         deallocate(grid);
@@ -184,8 +195,9 @@ namespace openvkl {
                                                   const vec3ui &rootOrigin)
     {
       std::vector<vec3ui> leafOffsets(numLeaves);
-      for (size_t i = 0; i < numLeaves; ++i)
+      tasking::parallel_for(numLeaves, [&](size_t i) {
         leafOffsets[i] = static_cast<vec3ui>(leafOrigin[i] - rootOrigin);
+      });
       return leafOffsets;
     }
 
@@ -221,178 +233,413 @@ namespace openvkl {
     }
 
     /*
-     * Initialize all (inner) levels. To do this, we must
-     * count the number of inner nodes per level, and allocate buffers for
-     * voxels and auxiliary data.
+     * Nodes are identified by codes which interleave the bits of the node
+     * position on its level (Morton order). Codes are unique per level, and
+     * the code of the parent node is obtained by shifting out the voxel index
+     * within the parent. This mapping preserves order, so that sorted lists of
+     * node codes on one level yield sorted lists on the parent level.
      */
-    void allocateInnerLevels(
+    inline uint64_t offsetToNodeCode(const vec3ui &offset, uint32_t level)
+    {
+      const uint32_t shift   = vklVdbLevelTotalLogRes(level);
+      const uint32_t numBits = vklVdbLevelTotalLogRes(0) - shift;
+      assert(3 * numBits <= 64);
+
+      uint64_t code = 0;
+      for (uint32_t b = 0; b < numBits; ++b) {
+        code |= ((uint64_t)((offset.x >> (shift + b)) & 1u)) << (3 * b + 2);
+        code |= ((uint64_t)((offset.y >> (shift + b)) & 1u)) << (3 * b + 1);
+        code |= ((uint64_t)((offset.z >> (shift + b)) & 1u)) << (3 * b);
+      }
+      return code;
+    }
+
+    inline vec3ui nodeCodeToOffset(uint64_t code, uint32_t level)
+    {
+      const uint32_t shift   = vklVdbLevelTotalLogRes(level);
+      const uint32_t numBits = vklVdbLevelTotalLogRes(0) - shift;
+
+      vec3ui offset(0u);
+      for (uint32_t b = 0; b < numBits; ++b) {
+        offset.x |= ((uint32_t)(code >> (3 * b + 2)) & 1u) << (shift + b);
+        offset.y |= ((uint32_t)(code >> (3 * b + 1)) & 1u) << (shift + b);
+        offset.z |= ((uint32_t)(code >> (3 * b)) & 1u) << (shift + b);
+      }
+      return offset;
+    }
+
+    inline uint64_t nodeCodeToParentCode(uint64_t code, uint32_t level)
+    {
+      return code >> (3 * vklVdbLevelLogRes(level - 1));
+    }
+
+    /*
+     * Sort in parallel: chunks are sorted independently, and then merged
+     * pairwise.
+     */
+    void parallelSort(std::vector<uint64_t> &values)
+    {
+      const size_t chunkSize = size_t(1) << 16;
+      const size_t numValues = values.size();
+      const size_t numChunks = (numValues + chunkSize - 1) / chunkSize;
+
+      if (numChunks <= 1) {
+        std::sort(values.begin(), values.end());
+        return;
+      }
+
+      tasking::parallel_for(numChunks, [&](size_t c) {
+        const size_t begin = c * chunkSize;
+        const size_t end   = std::min(numValues, begin + chunkSize);
+        std::sort(values.begin() + begin, values.begin() + end);
+      });
+
+      for (size_t width = chunkSize; width < numValues; width *= 2) {
+        const size_t numMerges = (numValues + 2 * width - 1) / (2 * width);
+        tasking::parallel_for(numMerges, [&](size_t m) {
+          const size_t begin  = m * 2 * width;
+          const size_t middle = std::min(numValues, begin + width);
+          const size_t end    = std::min(numValues, begin + 2 * width);
+          std::inplace_merge(values.begin() + begin,
+                             values.begin() + middle,
+                             values.begin() + end);
+        });
+      }
+    }
+
+    /*
+     * Compute the sorted codes of all inner nodes, per level. We go
+     * bottom-to-top, mapping the codes of all leaves and inner nodes on each
+     * level to their parent codes. The index of each inner node is its
+     * position in the list for its level.
+     */
+    std::vector<std::vector<uint64_t>> computeInnerNodeCodes(
         const std::vector<vec3ui> &leafOffsets,
-        const std::vector<std::vector<uint64_t>> &binnedLeaves,
-        std::vector<uint64_t> &capacity,
+        const std::vector<std::vector<uint64_t>> &binnedLeaves)
+    {
+      std::vector<std::vector<uint64_t>> innerCodes(vklVdbNumLevels());
+
+      for (uint32_t l = vklVdbNumLevels() - 1; l > 0; --l) {
+        const std::vector<uint64_t> &leaves = binnedLeaves[l];
+        std::vector<uint64_t> leafCodes(leaves.size());
+        tasking::parallel_for(leaves.size(), [&](size_t i) {
+          leafCodes[i] = offsetToNodeCode(leafOffsets[leaves[i]], l);
+        });
+        parallelSort(leafCodes);
+
+        std::vector<uint64_t> codes(leafCodes.size() + innerCodes[l].size());
+        std::merge(leafCodes.begin(),
+                   leafCodes.end(),
+                   innerCodes[l].begin(),
+                   innerCodes[l].end(),
+                   codes.begin());
+
+        // Leaves may not overlap other leaves, or inner nodes.
+        const auto duplicate = std::adjacent_find(codes.begin(), codes.end());
+        if (duplicate != codes.end()) {
+          runtimeError(
+              "Attempted to insert a leaf node into an existing node (level ",
+              l,
+              ", origin offset ",
+              nodeCodeToOffset(*duplicate, l),
+              ")");
+        }
+
+        tasking::parallel_for(codes.size(), [&](size_t i) {
+          codes[i] = nodeCodeToParentCode(codes[i], l);
+        });
+        codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+        innerCodes[l - 1] = std::move(codes);
+      }
+
+      return innerCodes;
+    }
+
+    /*
+     * The index of the voxel containing the given node or leaf in its parent
+     * level.
+     */
+    inline uint64_t parentVoxelIndex(
+        const std::vector<std::vector<uint64_t>> &innerCodes,
+        const vec3ui &offset,
+        uint32_t level)
+    {
+      const std::vector<uint64_t> &parentCodes = innerCodes[level - 1];
+      const uint64_t parentCode =
+          nodeCodeToParentCode(offsetToNodeCode(offset, level), level);
+      const auto parent =
+          std::lower_bound(parentCodes.begin(), parentCodes.end(), parentCode);
+      assert(parent != parentCodes.end() && *parent == parentCode);
+
+      const uint64_t parentIndex = parent - parentCodes.begin();
+      // NOTE: If this is every greater than 2^32-1 then we will have to
+      // use 64 bit addressing.
+      const uint64_t v = parentIndex * vklVdbLevelNumVoxels(level - 1) +
+                         offsetToLinearVoxelIndex(offset, level - 1);
+      assert(v < ((uint64_t)1) << 32);
+      return v;
+    }
+
+    /*
+     * Initialize all (inner) levels: allocate buffers for voxels and
+     * auxiliary data, and link each inner node to its parent. Node indices
+     * are known up front, so all nodes on a level are linked in parallel.
+     */
+    void buildInnerLevels(
+        const std::vector<std::vector<uint64_t>> &innerCodes,
+        bool hasQuantizedLeaves,
         VdbGrid *grid,
         size_t &bytesAllocated)
     {
-      // Comparator for voxel coordinates. We use this for sorting.
-      const auto isLess = [](const vec3i &a, const vec3i &b) {
-        return (a.x < b.x) || ((a.x == b.x) && (a.y < b.y)) ||
-               ((a.x == b.x) && (a.y == b.y) && (a.z < b.z));
-      };
-
-      // Origins on the previous level. These are offsets from grid->rootOrigin.
-      std::vector<vec3ui> oldInnerOrigins;
-
-      // From the leaf level, go upwards quantizing leaf origins
-      // to the respective level storage resolution, and count all
-      // active nodes.
-      for (int i = 0; i < vklVdbNumLevels() - 1; ++i) {
-        // We traverse bottom-to-top, starting at the leaf level (we will update
-        // the parent level!).
-        const int l = vklVdbNumLevels() - i - 1;
-
-        // Quantize all of this level's leaf origins to the node size, mapping
-        // offsets to inner node origins. We can do this using simple masking
-        // because node resolutions are powers of two.
-        std::vector<vec3ui> innerOrigins;
-        innerOrigins.reserve(oldInnerOrigins.size() + binnedLeaves[l].size());
-        for (uint64_t leaf : binnedLeaves[l])
-          innerOrigins.push_back(offsetToNodeOrigin(leafOffsets[leaf], l - 1));
-
-        // Also quanitize the child level's inner node origins.
-        for (const vec3ui &org : oldInnerOrigins)
-          innerOrigins.push_back(offsetToNodeOrigin(org, l - 1));
-
-        // We now have a list of inner node origins on level l-1, but it
-        // contains duplicates. Sort and remove duplicates, and store for next
-        // iterations.
-        std::sort(innerOrigins.begin(), innerOrigins.end(), isLess);
-        const auto end = std::unique(innerOrigins.begin(), innerOrigins.end());
-        const uint64_t levelNumInner = end - innerOrigins.begin();
-        innerOrigins.resize(levelNumInner);
-        oldInnerOrigins = std::move(innerOrigins);
-
-        if (levelNumInner > 0) {
-          assert(l > 1 ||
-                 levelNumInner ==
-                     1);  // This should be true at this point, but make sure...
-          VdbLevel &level = grid->levels[l - 1];
-          capacity[l - 1] = levelNumInner;
-          const size_t totalNumVoxels =
-              levelNumInner * vklVdbLevelNumVoxels(l - 1);
-          level.voxels     = allocate<uint64_t>(totalNumVoxels, bytesAllocated);
-          level.valueRange = allocate<range1f>(totalNumVoxels, bytesAllocated);
-          level.leafIndex  = allocate<uint64>(totalNumVoxels, bytesAllocated);
-          range1f empty;
-          std::fill(level.valueRange, level.valueRange + totalNumVoxels, empty);
+      assert(innerCodes[0].size() == 1);
+
+      for (uint32_t l = 0; l < vklVdbNumLevels() - 1; ++l) {
+        VdbLevel &level = grid->levels[l];
+        level.numNodes  = innerCodes[l].size();
+
+        const uint64_t numVoxels    = vklVdbLevelNumVoxels(l);
+        const size_t totalNumVoxels = level.numNodes * numVoxels;
+
+        level.voxels     = allocate<uint64_t>(totalNumVoxels, bytesAllocated);
+        level.valueRange = allocate<range1f>(totalNumVoxels, bytesAllocated);
+        level.leafIndex  = allocate<uint64>(totalNumVoxels, bytesAllocated);
+        if (hasQuantizedLeaves) {
+          level.leafQuantization =
+              allocate<VdbLeafQuantization>(totalNumVoxels, bytesAllocated);
         }
+
+        tasking::parallel_for(level.numNodes, [&](size_t i) {
+          const range1f empty;
+          std::fill(level.valueRange + i * numVoxels,
+                    level.valueRange + (i + 1) * numVoxels,
+                    empty);
+
+          if (l > 0) {
+            const vec3ui offset = nodeCodeToOffset(innerCodes[l][i], l);
+            const uint64_t v    = parentVoxelIndex(innerCodes, offset, l);
+
+            grid->levels[l - 1].voxels[v] = vklVdbVoxelMakeChildPtr(i);
+          }
+        });
       }
     }
 
     /*
-     * Compute the value range for float leaves.
+     * The data type that node data must have for the given format, or
+     * VKL_UNKNOWN if the format is not supported.
      */
-    range1f computeValueRangeFloat(VKLVdbLeafFormat format,
-                                   uint32_t level,
-                                   const Data *data)
+    VKLDataType leafFormatDataType(VKLVdbLeafFormat format)
     {
-      range1f range;
-      const float *buffer = data->begin<float>();
+      switch (format) {
+      case VKL_VDB_FORMAT_TILE:
+      case VKL_VDB_FORMAT_CONSTANT:
+        return VKL_FLOAT;
+      case VKL_VDB_FORMAT_CONSTANT_HALF:
+        return VKL_HALF;
+      case VKL_VDB_FORMAT_CONSTANT_UCHAR:
+        return VKL_UCHAR;
+      case VKL_VDB_FORMAT_CONSTANT_USHORT:
+        return VKL_USHORT;
+      default:
+        return VKL_UNKNOWN;
+      }
+    }
+
+    inline bool isQuantizedLeafFormat(VKLVdbLeafFormat format)
+    {
+      return format == VKL_VDB_FORMAT_CONSTANT_UCHAR ||
+             format == VKL_VDB_FORMAT_CONSTANT_USHORT;
+    }
 
+    /*
+     * The encoding stored in leaf pointer voxels for the given (constant)
+     * format.
+     */
+    VdbLeafEncoding leafFormatEncoding(VKLVdbLeafFormat format)
+    {
       switch (format) {
-      case VKL_VDB_FORMAT_TILE: {
-        range.extend(buffer[0]);
-        break;
+      case VKL_VDB_FORMAT_CONSTANT_HALF:
+        return VDB_LEAF_ENCODING_HALF;
+      case VKL_VDB_FORMAT_CONSTANT_UCHAR:
+        return VDB_LEAF_ENCODING_UCHAR;
+      case VKL_VDB_FORMAT_CONSTANT_USHORT:
+        return VDB_LEAF_ENCODING_USHORT;
+      default:
+        assert(format == VKL_VDB_FORMAT_CONSTANT);
+        return VDB_LEAF_ENCODING_FLOAT;
       }
+    }
 
-      case VKL_VDB_FORMAT_CONSTANT: {
-        range1f leafRange;
-        CALL_ISPC(VdbSampler_valueRangeConstantFloat,
-                  buffer,
-                  static_cast<uint32_t>(vklVdbLevelNumVoxels(level)),
-                  reinterpret_cast<ispc::box1f *>(&leafRange));
+    /*
+     * Verify that the format is supported, and that the node data has the
+     * correct type and size for it.
+     */
+    void validateLeafData(VKLVdbLeafFormat format,
+                          uint32_t level,
+                          const Data *data)
+    {
+      const VKLDataType dataType = leafFormatDataType(format);
+      if (dataType == VKL_UNKNOWN) {
+        runtimeError(
+            "Only VKL_VDB_FORMAT_TILE and VKL_VDB_FORMAT_CONSTANT (with float, "
+            "half, uchar, or ushort values) are supported.");
+      }
 
-        range.extend(leafRange.lower);
-        range.extend(leafRange.upper);
-        break;
+      if (data->dataType != dataType) {
+        runtimeError("node data for format ",
+                     format,
+                     " has type ",
+                     data->dataType,
+                     " but must have type ",
+                     dataType);
       }
 
+      const uint32_t numVoxels = (format == VKL_VDB_FORMAT_TILE)
+                                     ? 1
+                                     : vklVdbLevelNumVoxels(level);
+      if (data->size() < numVoxels) {
+        runtimeError("node data for format ",
+                     format,
+                     " on level ",
+                     level,
+                     " must have at least ",
+                     numVoxels,
+                     " entries");
+      }
+    }
+
+    /*
+     * Compute the value range for leaves of any supported format. Quantized
+     * values are reconstructed using the given quantization. The leaf data
+     * must have been validated.
+     */
+    range1f computeValueRange(VKLVdbLeafFormat format,
+                              uint32_t level,
+                              const Data *data,
+                              const VdbLeafQuantization &quantization)
+    {
+      const uint32_t numVoxels = (format == VKL_VDB_FORMAT_TILE)
+                                     ? 1
+                                     : vklVdbLevelNumVoxels(level);
+
+      range1f leafRange;
+      ispc::box1f *ispcRange = reinterpret_cast<ispc::box1f *>(&leafRange);
+
+      switch (format) {
+      case VKL_VDB_FORMAT_TILE:
+        leafRange.extend(data->begin<float>()[0]);
+        break;
+      case VKL_VDB_FORMAT_CONSTANT:
+        CALL_ISPC(VdbSampler_valueRangeConstantFloat,
+                  data->begin<float>(),
+                  numVoxels,
+                  ispcRange);
+        break;
+      case VKL_VDB_FORMAT_CONSTANT_HALF:
+        CALL_ISPC(VdbSampler_valueRangeConstantHalf,
+                  data->begin<uint16_t>(),
+                  numVoxels,
+                  ispcRange);
+        break;
+      case VKL_VDB_FORMAT_CONSTANT_UCHAR:
+        CALL_ISPC(VdbSampler_valueRangeConstantUChar,
+                  data->begin<uint8_t>(),
+                  numVoxels,
+                  ispcRange);
+        break;
+      case VKL_VDB_FORMAT_CONSTANT_USHORT:
+        CALL_ISPC(VdbSampler_valueRangeConstantUShort,
+                  data->begin<uint16_t>(),
+                  numVoxels,
+                  ispcRange);
+        break;
       default:
-        runtimeError(
-            "Only VKL_VDB_FORMAT_TILE and VLK_VDB_FORMAT_CONST are supported.");
+        assert(false);
       }
 
+      if (!isQuantizedLeafFormat(format))
+        return leafRange;
+
+      // The range of stored values does not include scale and offset. Note
+      // that the scale may be negative.
+      range1f range;
+      range.extend(quantization.offset + quantization.scale * leafRange.lower);
+      range.extend(quantization.offset + quantization.scale * leafRange.upper);
       return range;
     }
 
     /*
-     * Insert leaf nodes into the tree, creating inner nodes as needed.
-     * This function does not allocate anything; allocateInnerLevels() has done
-     * this already.
+     * Insert leaf nodes into the tree, in parallel. This function does not
+     * allocate anything; buildInnerLevels() has done this already. Leaves
+     * occupy distinct voxels, so they can be written independently.
      */
-    void insertLeavesFloat(
-        const std::vector<vec3ui> &leafOffsets,
-        const uint32_t *leafFormat,
-        const Data *const *leafData,
-        const std::vector<std::vector<uint64_t>> &binnedLeaves,
-        const std::vector<uint64_t> &capacity,
-        VdbGrid *grid)
-    {
-      assert(capacity[0] == 1);
-      grid->levels[0].numNodes = 1;
-
-      for (size_t leafLevel = 0; leafLevel < binnedLeaves.size(); ++leafLevel) {
-        const auto &leaves = binnedLeaves[leafLevel];
-        for (uint64_t idx : leaves) {
-          const auto format = static_cast<VKLVdbLeafFormat>(leafFormat[idx]);
-          const range1f leafValueRange =
-              computeValueRangeFloat(format, leafLevel, leafData[idx]);
-
-          const vec3ui &offset = leafOffsets[idx];
-          uint64_t nodeIndex   = 0;
-          for (size_t l = 0; l < leafLevel; ++l) {
-            VdbLevel &level = grid->levels[l];
-            // PRECOND: nodeIndex is valid.
-            assert(nodeIndex < level.numNodes);
-
-            const uint64_t voxelIndex = offsetToLinearVoxelIndex(offset, l);
-            // NOTE: If this is every greater than 2^32-1 then we will have to
-            // use 64 bit addressing.
-            const uint64_t v = nodeIndex * vklVdbLevelNumVoxels(l) + voxelIndex;
-            assert(v < ((uint64_t)1) << 32);
-
-            level.valueRange[v].extend(leafValueRange);
-
-            uint64_t &voxel = level.voxels[v];
-            if (vklVdbVoxelIsLeafPtr(voxel) || vklVdbVoxelIsTile(voxel)) {
-              assert(false);
-              runtimeError(
-                  "Attempted to insert a leaf node into a leaf node (level ",
-                  l + 1,
-                  ", origin ",
-                  offsetToNodeOrigin(offset, l),
-                  ")");
-
-            } else if (vklVdbVoxelIsEmpty(voxel)) {
-              const size_t nl = l + 1;
-              if (nl < leafLevel) {
-                nodeIndex = grid->levels[nl].numNodes++;
-                assert(grid->levels[nl].numNodes <= capacity[nl]);
-                voxel = vklVdbVoxelMakeChildPtr(nodeIndex);
-              } else {
-                if (format == VKL_VDB_FORMAT_TILE) {
-                  voxel = vklVdbVoxelMakeTile(leafData[idx]->begin<float>()[0]);
-                } else if (format == VKL_VDB_FORMAT_CONSTANT)
-                  voxel = vklVdbVoxelMakeLeafPtr(leafData[idx]->data, format);
-                else
-                  assert(false);
-
-                level.leafIndex[v] = idx;
-              }
-            } else {
-              nodeIndex = vklVdbVoxelChildGetIndex(voxel);
-              assert(nodeIndex < grid->levels[l + 1].numNodes);
-            }
-          }
+    void insertLeaves(const std::vector<vec3ui> &leafOffsets,
+                      const uint32_t *leafLevel,
+                      const uint32_t *leafFormat,
+                      const Data *const *leafData,
+                      const float *leafQuantizationScale,
+                      const float *leafQuantizationOffset,
+                      const std::vector<std::vector<uint64_t>> &innerCodes,
+                      VdbGrid *grid)
+    {
+      tasking::parallel_for(leafOffsets.size(), [&](size_t idx) {
+        const auto format = static_cast<VKLVdbLeafFormat>(leafFormat[idx]);
+
+        VdbLeafQuantization quantization;
+        quantization.scale  = 1.f;
+        quantization.offset = 0.f;
+        if (isQuantizedLeafFormat(format)) {
+          quantization.scale  = leafQuantizationScale[idx];
+          quantization.offset = leafQuantizationOffset[idx];
+        }
+
+        const uint32_t l = leafLevel[idx];
+        const uint64_t v = parentVoxelIndex(innerCodes, leafOffsets[idx], l);
+        VdbLevel &level  = grid->levels[l - 1];
+        assert(vklVdbVoxelIsEmpty(level.voxels[v]));
+
+        level.valueRange[v] =
+            computeValueRange(format, l, leafData[idx], quantization);
+
+        if (format == VKL_VDB_FORMAT_TILE) {
+          level.voxels[v] =
+              vklVdbVoxelMakeTile(leafData[idx]->begin<float>()[0]);
+        } else {
+          level.voxels[v] = vklVdbVoxelMakeLeafPtr(leafData[idx]->data,
+                                                   leafFormatEncoding(format));
+          if (isQuantizedLeafFormat(format))
+            level.leafQuantization[v] = quantization;
         }
+
+        level.leafIndex[v] = idx;
+      });
+    }
+
+    /*
+     * Propagate value ranges from the leaves to the root. Inner node voxels
+     * on each level are independent, so we reduce in parallel level by level,
+     * bottom-to-top.
+     */
+    void computeInnerValueRanges(VdbGrid *grid)
+    {
+      for (int l = int(vklVdbNumLevels()) - 3; l >= 0; --l) {
+        VdbLevel &level               = grid->levels[l];
+        const VdbLevel &childLevel    = grid->levels[l + 1];
+        const uint64_t numChildVoxels = vklVdbLevelNumVoxels(l + 1);
+
+        tasking::parallel_for(
+            level.numNodes * vklVdbLevelNumVoxels(l), [&](size_t v) {
+              const uint64_t voxel = level.voxels[v];
+              if (!vklVdbVoxelIsChildPtr(voxel))
+                return;
+
+              const uint64_t begin =
+                  vklVdbVoxelChildGetIndex(voxel) * numChildVoxels;
+              range1f range;
+              for (uint64_t c = begin; c < begin + numChildVoxels; ++c)
+                range.extend(childLevel.valueRange[c]);
+              level.valueRange[v] = range;
+            });
       }
     }
 
@@ -457,6 +704,13 @@ namespace openvkl {
       Ref<Data> dataData =
           (Data *)this->template getParam<ManagedObject::VKL_PTR>("data",
                                                                   nullptr);
+      // Float values per node, only used for nodes with quantized formats.
+      Ref<Data> dataQuantizationScale =
+          (Data *)this->template getParam<ManagedObject::VKL_PTR>(
+              "quantizationScale", nullptr);
+      Ref<Data> dataQuantizationOffset =
+          (Data *)this->template getParam<ManagedObject::VKL_PTR>(
+              "quantizationOffset", nullptr);
 
       // Sanity checks.
       // We will assume that the following conditions hold downstream, so
@@ -482,6 +736,9 @@ namespace openvkl {
         runtimeError("data is not set");
 
       const size_t numLeaves = dataLevel->size();
+      if (numLeaves == 0)
+        runtimeError("there must be at least one leaf node");
+
       if (dataOrigin->size() != numLeaves || dataFormat->size() != numLeaves ||
           dataData->size() != numLeaves) {
         runtimeError(
@@ -493,9 +750,34 @@ namespace openvkl {
       const uint32_t *leafFormat  = dataFormat->begin<uint32_t>();
       const Data *const *leafData = dataData->begin<const Data *>();
 
-      grid         = allocate<VdbGrid>(1, bytesAllocated);
-      grid->type   = type;
-      grid->filter = filter;
+      const bool hasQuantizedLeaves =
+          std::any_of(leafFormat, leafFormat + numLeaves, [](uint32_t format) {
+            return isQuantizedLeafFormat(static_cast<VKLVdbLeafFormat>(format));
+          });
+
+      if (hasQuantizedLeaves &&
+          (!dataQuantizationScale || !dataQuantizationOffset ||
+           dataQuantizationScale->size() != numLeaves ||
+           dataQuantizationOffset->size() != numLeaves)) {
+        runtimeError(
+            "quantizationScale and quantizationOffset must be set, and have "
+            "the same size as level, if there are quantized nodes");
+      }
+
+      // Validate all leaves up front, so that the parallel build below
+      // cannot fail.
+      for (size_t i = 0; i < numLeaves; ++i) {
+        if (leafLevel[i] >= vklVdbNumLevels())
+          runtimeError("leaf level ", leafLevel[i], " is out of range");
+        validateLeafData(static_cast<VKLVdbLeafFormat>(leafFormat[i]),
+                         leafLevel[i],
+                         leafData[i]);
+      }
+
+      grid                   = allocate<VdbGrid>(1, bytesAllocated);
+      grid->commitGeneration = nextCommitGeneration++;
+      grid->type             = type;
+      grid->filter           = filter;
       grid->maxSamplingDepth =
           min(max(maxSamplingDepth, 0), VKL_VDB_NUM_LEVELS - 1);
       grid->maxIteratorDepth =
@@ -523,15 +805,21 @@ namespace openvkl {
       const auto leafOffsets =
           computeLeafOffsets(numLeaves, leafOrigin, grid->rootOrigin);
 
-      // Allocate buffers for all levels now, all in one go. This makes
-      // inserting the nodes (below) much faster.
-      std::vector<uint64_t> capacity(vklVdbNumLevels() - 1, 0);
-      allocateInnerLevels(
-          leafOffsets, binnedLeaves, capacity, grid, bytesAllocated);
+      // Determine all inner nodes first, then allocate buffers for all
+      // levels in one go. This lets us insert the leaves (below) in parallel.
+      const auto innerCodes = computeInnerNodeCodes(leafOffsets, binnedLeaves);
+      buildInnerLevels(innerCodes, hasQuantizedLeaves, grid, bytesAllocated);
+
+      insertLeaves(leafOffsets,
+                   leafLevel,
+                   leafFormat,
+                   leafData,
+                   getDataPtr<const float>(dataQuantizationScale.ptr),
+                   getDataPtr<const float>(dataQuantizationOffset.ptr),
+                   innerCodes,
+                   grid);
 
-      // TODO: Support other types?
-      insertLeavesFloat(
-          leafOffsets, leafFormat, leafData, binnedLeaves, capacity, grid);
+      computeInnerValueRanges(grid);
 
       valueRange = range1f();
       for (size_t i = 0; i < vklVdbLevelNumVoxels(0); ++i)
@@ -564,6 +852,53 @@ namespace openvkl {
                 static_cast<float *>(samples));
     }
 
+    template <int W>
+    void VdbVolume<W>::initAccessor(VKLAccessor &accessor) const
+    {
+      static_assert(sizeof(VdbAccessor) <= ACCESSOR_INTERNAL_STATE_SIZE,
+                    "accessor internal state size must be >= VdbAccessor size");
+      static_assert(alignof(VdbAccessor) <= ACCESSOR_INTERNAL_STATE_ALIGNMENT,
+                    "accessor internal state alignment must be >= "
+                    "VdbAccessor alignment");
+
+      if (!grid)
+        throw std::runtime_error(
+            "Trying to create an accessor on a vdb volume that was not "
+            "committed.");
+
+      VdbAccessor *vdbAccessor = new (&accessor.internalState) VdbAccessor;
+      vdbAccessor->grid             = grid;
+      vdbAccessor->commitGeneration = grid->commitGeneration;
+      vdbAccessor->depth            = 0;
+      vdbAccessor->nodeOrigin[0]    = vec3ui(0);
+      vdbAccessor->nodeIndex[0]     = 0;
+    }
+
+    template <int W>
+    void VdbVolume<W>::computeSampleWithAccessor(
+        VKLAccessor &accessor,
+        const vvec3fn<1> &objectCoordinates,
+        vfloatn<1> &sample) const
+    {
+      CALL_ISPC(VdbSampler_computeSample_accessor,
+                this->ispcEquivalent,
+                &accessor.internalState,
+                &objectCoordinates,
+                static_cast<float *>(sample));
+    }
+
+    template <int W>
+    void VdbVolume<W>::computeGradientV(const vintn<W> &valid,
+                                        const vvec3fn<W> &objectCoordinates,
+                                        vvec3fn<W> &gradients) const
+    {
+      CALL_ISPC(VdbSampler_computeGradient,
+                static_cast<const int *>(valid),
+                this->ispcEquivalent,
+                &objectCoordinates,
+                &gradients);
+    }
+
     template <int W>
     VKLObserver VdbVolume<W>::newObserver(const char *type)
     {
@@ -53,16 +53,26 @@ namespace openvkl {
       void computeSample(const vvec3fn<1> &objectCoordinates,
                          vfloatn<1> &samples) const override;
 
+      /*
+       * Initialize an accessor, which caches the inner nodes visited by
+       * the most recent sample.
+       */
+      void initAccessor(VKLAccessor &accessor) const override;
+
+      /*
+       * Scalar sampling, starting traversal at the nodes cached in the
+       * accessor.
+       */
+      void computeSampleWithAccessor(VKLAccessor &accessor,
+                                     const vvec3fn<1> &objectCoordinates,
+                                     vfloatn<1> &sample) const override;
+
       /*
        * Compute the volume gradient at the given coordinates.
-       * NOT IMPLEMENTED.
        */
       void computeGradientV(const vintn<W> &valid,
                             const vvec3fn<W> &objectCoordinates,
-                            vvec3fn<W> &gradients) const override
-      {
-        THROW_NOT_IMPLEMENTED;
-      }
+                            vvec3fn<W> &gradients) const override;
 
       /*
        * Obtain the volume bounding box.
@@ -65,6 +65,9 @@ typedef enum
   // Unsigned 64-bit integer scalar and vector types.
   VKL_ULONG = 5550, VKL_VEC2UL, VKL_VEC3UL, VKL_VEC4UL,
 
+  // Half precision (IEEE 754 binary16) floating point scalar type.
+  VKL_HALF = 5800,
+
   // Single precision floating point scalar and vector types.
   VKL_FLOAT = 6000, VKL_VEC2F, VKL_VEC3F, VKL_VEC4F,
 
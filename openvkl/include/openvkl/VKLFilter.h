@@ -0,0 +1,30 @@
+// Copyright 2019-2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#if __cplusplus >= 201103L
+#include <cstdint>
+#endif
+
+// this header is shared with ISPC
+
+// An enum that represents the different filter types available for sampling
+// volumes, set via the "filter" parameter on volumes which support it.
+#if __cplusplus >= 201103L
+typedef enum : uint32_t
+#else
+typedef enum
+#endif
+{
+  // Only read the voxel the sample position is in, treating it as
+  // constant.
+  VKL_FILTER_NEAREST = 0,
+  // Read the eight voxels surrounding the sample position, and
+  // interpolate trilinearly.
+  VKL_FILTER_TRILINEAR = 100,
+  // Read the 64 voxels surrounding the sample position, and interpolate
+  // with a tricubic B-spline. This gives smooth results (with continuous
+  // gradients), but slightly blurs the data.
+  VKL_FILTER_TRICUBIC = 200,
+} VKLFilter;
@@ -0,0 +1,42 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "common.h"
+#include "volume.h"
+
+// Accessors cache the parts of a volume's acceleration structure visited by
+// the most recent sample, so that subsequent nearby samples may skip most of
+// the traversal. Accessors are application-allocated, and must not be used by
+// multiple threads at the same time. Volumes which do not benefit from
+// caching ignore the accessor.
+
+#define ACCESSOR_INTERNAL_STATE_ALIGNMENT 16
+#define ACCESSOR_INTERNAL_STATE_SIZE 256
+
+typedef struct
+{
+  VKL_ALIGN(ACCESSOR_INTERNAL_STATE_ALIGNMENT)
+  char internalState[ACCESSOR_INTERNAL_STATE_SIZE];
+  VKLVolume volume;
+} VKLAccessor;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Initialize an accessor for the given committed volume. Accessors discard
+// their cache when the volume is committed again.
+OPENVKL_INTERFACE
+void vklInitAccessor(VKLAccessor *accessor, VKLVolume volume);
+
+// Same as vklComputeSample() on the accessor's volume, using and updating the
+// accessor's cache.
+OPENVKL_INTERFACE
+float vklComputeSampleWithAccessor(VKLAccessor *accessor,
+                                   const vkl_vec3f *objectCoordinates);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -19,6 +19,10 @@ typedef enum
 {
   VKL_DATA_DEFAULT       = 0,
   VKL_DATA_SHARED_BUFFER = (1 << 0),
+
+  // the library's copy of the data is allocated with its pages interleaved
+  // over all NUMA nodes; ignored for shared buffers
+  VKL_DATA_NUMA_INTERLEAVED = (1 << 1),
 } VKLDataCreationFlags;
 
 #ifdef __cplusplus
@@ -41,6 +45,15 @@ OPENVKL_INTERFACE VKLData vklNewData(size_t numItems,
                                      VKLDataCreationFlags dataCreationFlags
                                          VKL_DEFAULT_VAL(= VKL_DATA_DEFAULT));
 
+// Creates a data object backed by a read-only memory mapping of numItems items
+// of the given type, starting at the given byte offset in a file. The file is
+// not read on creation; pages are loaded on demand by the operating system.
+// The file must not be modified or truncated while the data object exists.
+OPENVKL_INTERFACE VKLData vklNewDataFromFile(const char *filename,
+                                             size_t offset,
+                                             size_t numItems,
+                                             VKLDataType dataType);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
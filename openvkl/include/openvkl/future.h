@@ -0,0 +1,45 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "common.h"
+
+// Futures track the completion of asynchronous operations.
+
+#ifdef __cplusplus
+struct Future : public ManagedObject
+{
+};
+#else
+typedef ManagedObject Future;
+#endif
+
+typedef Future *VKLFuture;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Commit the object on the tasking system, returning immediately.
+// The object must not be used (including setting its parameters, committing
+// or sampling it) until the returned future is ready; releasing it is
+// allowed. Distinct objects may be committed concurrently.
+// The future must be released with vklRelease, which waits for completion.
+// Triggers the error handler and returns NULL on error.
+OPENVKL_INTERFACE
+VKLFuture vklCommitAsync(VKLObject object);
+
+// Returns 1 if the operation has completed, 0 otherwise.
+// Does not block.
+OPENVKL_INTERFACE
+int vklIsReady(VKLFuture future);
+
+// Blocks until the operation has completed.
+// Triggers the error handler if the operation failed.
+OPENVKL_INTERFACE
+void vklWait(VKLFuture future);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
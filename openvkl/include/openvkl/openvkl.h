@@ -5,11 +5,14 @@
 
 #include "VKLDataType.h"
 #include "VKLError.h"
+#include "VKLFilter.h"
 #include "VKLLogLevel.h"
 
+#include "accessor.h"
 #include "common.h"
 #include "data.h"
 #include "driver.h"
+#include "future.h"
 #include "iterator.h"
 #include "module.h"
 #include "observer.h"
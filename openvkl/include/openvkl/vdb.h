@@ -9,6 +9,7 @@
 #pragma once
 
 #include "VKLDataType.h"
+#include "VKLFilter.h"
 #include "ispc_cpp_interop.h"
 
 // ========================================================================== //
@@ -215,23 +216,6 @@ inline varying vkl_uint64 vklVdbDomainOffsetToLinear(varying vkl_uint32 level,
 
 #undef __vkl_vdb_switch_case
 
-// ========================================================================== //
-// An enum that represents the different filter types available in vdb volumes.
-// ========================================================================== //
-#if __cplusplus >= 201103L
-enum VKLFilter : vkl_uint32
-#else
-enum VKLFilter
-#endif
-{
-  // Only read the voxel the sample position is in, treating it as
-  // constant.
-  VKL_FILTER_NEAREST = 0,
-  // Read the eight voxels surrounding the sample position, and
-  // interpolate trilinearly.
-  VKL_FILTER_TRILINEAR = 100,
-};
-
 // ========================================================================== //
 // An enum for leaf data format constants.
 // This value determines how the leaf data buffer is interpreted by VKL
@@ -255,5 +239,14 @@ enum VKLVdbLeafFormat
   // The data is a temporally unstructured volume (TUV).
   // TODO: Support this format.
   VKL_VDB_FORMAT_TUV,
+  // The data is temporally constant, and the buffer contains an array of
+  // vklVdbNumVoxels(level) values of type VKL_HALF.
+  VKL_VDB_FORMAT_CONSTANT_HALF,
+  // The data is temporally constant, and the buffer contains an array of
+  // vklVdbNumVoxels(level) quantized values q of type VKL_UCHAR. Values are
+  // reconstructed as offset + scale * q, with a scale and offset per node.
+  VKL_VDB_FORMAT_CONSTANT_UCHAR,
+  // Same as VKL_VDB_FORMAT_CONSTANT_UCHAR, with values of type VKL_USHORT.
+  VKL_VDB_FORMAT_CONSTANT_USHORT,
   VKL_VDB_FORMAT_INVALID
 };
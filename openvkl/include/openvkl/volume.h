@@ -46,6 +46,36 @@ typedef enum
   VKL_AMR_OCTANT
 } VKLAMRMethod;
 
+// voxel memory layouts for structured regular volumes
+typedef enum
+# if __cplusplus >= 201103L
+: uint8_t
+#endif
+{
+  VKL_STRUCTURED_LAYOUT_LINEAR,
+  VKL_STRUCTURED_LAYOUT_BRICKED,
+  VKL_STRUCTURED_LAYOUT_MORTON
+} VKLStructuredLayout;
+
+// gradient computation methods for structured regular volumes
+typedef enum
+# if __cplusplus >= 201103L
+: uint8_t
+#endif
+{
+  VKL_GRADIENT_ANALYTIC,
+  VKL_GRADIENT_CENTRAL_DIFFERENCES,
+  VKL_GRADIENT_FORWARD_DIFFERENCES
+} VKLGradientMethod;
+
+// application callback providing voxel data for out-of-core structured regular
+// volumes. must write the voxels of the given region of voxel indices (lower
+// and upper bounds are inclusive) as floats in x-fastest order. may be called
+// from any thread, but not concurrently for the same volume.
+typedef void (*VKLLoadVoxelsFunction)(void *userData,
+                                      const vkl_box3i *region,
+                                      float *voxels);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -74,6 +104,24 @@ void vklComputeSample16(const int *valid,
                         const vkl_vvec3f16 *objectCoordinates,
                         float *samples);
 
+// Sample N object coordinates given as an array of structures. Coordinates are
+// processed internally in packets of the driver's native SIMD width, and large
+// streams may be distributed across threads.
+OPENVKL_INTERFACE
+void vklComputeSampleN(VKLVolume volume,
+                       unsigned int N,
+                       const vkl_vec3f *objectCoordinates,
+                       float *samples);
+
+// Same as vklComputeSampleN(), with coordinates given as a structure of arrays.
+OPENVKL_INTERFACE
+void vklComputeSampleNSOA(VKLVolume volume,
+                          unsigned int N,
+                          const float *objectCoordinatesX,
+                          const float *objectCoordinatesY,
+                          const float *objectCoordinatesZ,
+                          float *samples);
+
 OPENVKL_INTERFACE
 vkl_vec3f vklComputeGradient(VKLVolume volume,
                              const vkl_vec3f *objectCoordinates);
@@ -96,11 +144,75 @@ void vklComputeGradient16(const int *valid,
                           const vkl_vvec3f16 *objectCoordinates,
                           vkl_vvec3f16 *gradients);
 
+// Computes both the sample value and the gradient at each of N object
+// coordinates. This is more efficient than separate vklComputeSampleN() and
+// vklComputeGradient*() calls, as the sample value is reused in the gradient
+// computation.
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradientN(VKLVolume volume,
+                                  unsigned int N,
+                                  const vkl_vec3f *objectCoordinates,
+                                  float *samples,
+                                  vkl_vec3f *gradients);
+
+// Returns the number of attributes of the volume. Structured volumes may have
+// multiple attributes, for example density and temperature defined on the same
+// grid; all other volumes have a single attribute.
+OPENVKL_INTERFACE
+unsigned int vklGetNumAttributes(VKLVolume volume);
+
+// Samples the M attributes with the given indices at a single object
+// coordinate, writing one sample per attribute. This is more efficient than
+// sampling the attributes separately, as the coordinate transformation and
+// voxel addressing are shared between all attributes. The single-attribute
+// sampling functions sample attribute 0.
+OPENVKL_INTERFACE
+void vklComputeSampleM(VKLVolume volume,
+                       const vkl_vec3f *objectCoordinates,
+                       float *samples,
+                       unsigned int M,
+                       const unsigned int *attributeIndices);
+
+// Same as vklComputeSampleM(), for N object coordinates. The sample of
+// attribute attributeIndices[i] at coordinate j is written to
+// samples[i * N + j].
+OPENVKL_INTERFACE
+void vklComputeSampleMN(VKLVolume volume,
+                        unsigned int N,
+                        const vkl_vec3f *objectCoordinates,
+                        float *samples,
+                        unsigned int M,
+                        const unsigned int *attributeIndices);
+
+// Sample time-varying volumes at the given time in [0, 1], interpolating
+// between the two adjacent timesteps. Volumes which do not vary over time
+// ignore the time.
+OPENVKL_INTERFACE
+float vklComputeSampleAtTime(VKLVolume volume,
+                             const vkl_vec3f *objectCoordinates,
+                             float time);
+
+// Stream version of vklComputeSampleAtTime(), with one time per coordinate.
+OPENVKL_INTERFACE
+void vklComputeSampleAtTimeN(VKLVolume volume,
+                             unsigned int N,
+                             const vkl_vec3f *objectCoordinates,
+                             const float *times,
+                             float *samples);
+
 OPENVKL_INTERFACE
 vkl_box3f vklGetBoundingBox(VKLVolume volume);
 
 OPENVKL_INTERFACE vkl_range1f vklGetValueRange(VKLVolume volume);
 
+// Updates a committed volume after the application modified its voxel data in
+// place (through a shared buffer), for the given region of voxel indices
+// (lower and upper bounds are inclusive). Only the acceleration structures
+// depending on the modified voxels and the volume value range are recomputed,
+// which is much cheaper than recommitting the volume for small regions.
+OPENVKL_INTERFACE
+void vklVolumeInvalidateRegion(VKLVolume volume, const vkl_box3i *region);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,201 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+static std::vector<VKLInterval> getIntervals(VKLVolume volume)
+{
+  const vkl_box3f boundingBox = vklGetBoundingBox(volume);
+
+  // diagonally through the volume, starting outside
+  vkl_vec3f origin{boundingBox.lower.x - 1.f,
+                   boundingBox.lower.y - 1.f,
+                   boundingBox.lower.z - 1.f};
+  vkl_vec3f direction{1.f, 1.f, 1.f};
+  vkl_range1f tRange{0.f, inf};
+
+  VKLIntervalIterator iterator;
+  vklInitIntervalIterator(
+      &iterator, volume, &origin, &direction, &tRange, nullptr);
+
+  std::vector<VKLInterval> intervals;
+
+  VKLInterval interval;
+
+  while (vklIterateInterval(&iterator, &interval)) {
+    intervals.push_back(interval);
+  }
+
+  return intervals;
+}
+
+static void requireMatchingAccelerators(VKLVolume volume, VKLVolume reference)
+{
+  const vkl_range1f valueRange          = vklGetValueRange(volume);
+  const vkl_range1f referenceValueRange = vklGetValueRange(reference);
+
+  REQUIRE(valueRange.lower == referenceValueRange.lower);
+  REQUIRE(valueRange.upper == referenceValueRange.upper);
+
+  const vkl_box3f boundingBox          = vklGetBoundingBox(volume);
+  const vkl_box3f referenceBoundingBox = vklGetBoundingBox(reference);
+
+  REQUIRE(boundingBox.lower.x == referenceBoundingBox.lower.x);
+  REQUIRE(boundingBox.lower.y == referenceBoundingBox.lower.y);
+  REQUIRE(boundingBox.lower.z == referenceBoundingBox.lower.z);
+  REQUIRE(boundingBox.upper.x == referenceBoundingBox.upper.x);
+  REQUIRE(boundingBox.upper.y == referenceBoundingBox.upper.y);
+  REQUIRE(boundingBox.upper.z == referenceBoundingBox.upper.z);
+
+  const std::vector<VKLInterval> intervals = getIntervals(volume);
+  const std::vector<VKLInterval> referenceIntervals = getIntervals(reference);
+
+  REQUIRE(intervals.size() == referenceIntervals.size());
+
+  for (size_t i = 0; i < intervals.size(); i++) {
+    INFO("interval " << i);
+
+    REQUIRE(intervals[i].tRange.lower == referenceIntervals[i].tRange.lower);
+    REQUIRE(intervals[i].tRange.upper == referenceIntervals[i].tRange.upper);
+    REQUIRE(intervals[i].valueRange.lower ==
+            referenceIntervals[i].valueRange.lower);
+    REQUIRE(intervals[i].valueRange.upper ==
+            referenceIntervals[i].valueRange.upper);
+  }
+}
+
+static bool fileExists(const std::string &filename)
+{
+  return std::ifstream(filename).good();
+}
+
+static void commitWithCache(TestingVolume &volume, const std::string &filename)
+{
+  VKLVolume vklVolume = volume.getVKLVolume();
+  vklSetString(vklVolume, "acceleratorCacheFile", filename.c_str());
+  vklCommit(vklVolume);
+}
+
+TEST_CASE("Accelerator cache", "[volume_value_range]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const std::string filename = "vklTests_accelerator_cache.bin";
+  std::remove(filename.c_str());
+
+  SECTION("structured regular volumes")
+  {
+    WaveletStructuredRegularVolume<float> reference(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+
+    // the first commit builds and writes the cache, the second one reads it
+    WaveletStructuredRegularVolume<float> writer(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+    commitWithCache(writer, filename);
+
+    REQUIRE(fileExists(filename));
+    requireMatchingAccelerators(writer.getVKLVolume(),
+                                reference.getVKLVolume());
+
+    WaveletStructuredRegularVolume<float> reader(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+    commitWithCache(reader, filename);
+
+    requireMatchingAccelerators(reader.getVKLVolume(),
+                                reference.getVKLVolume());
+  }
+
+  SECTION("structured spherical volumes")
+  {
+    WaveletStructuredSphericalVolume<float> reference(
+        vec3i(64), vec3f(0.f), vec3f(1.f, 2.f, 2.f));
+
+    WaveletStructuredSphericalVolume<float> writer(
+        vec3i(64), vec3f(0.f), vec3f(1.f, 2.f, 2.f));
+    commitWithCache(writer, filename);
+
+    WaveletStructuredSphericalVolume<float> reader(
+        vec3i(64), vec3f(0.f), vec3f(1.f, 2.f, 2.f));
+    commitWithCache(reader, filename);
+
+    requireMatchingAccelerators(reader.getVKLVolume(),
+                                reference.getVKLVolume());
+  }
+
+  SECTION("unstructured volumes")
+  {
+    for (VKLUnstructuredCellType cellType : {VKL_HEXAHEDRON, VKL_TETRAHEDRON}) {
+      INFO("cellType = " << int(cellType));
+
+      std::remove(filename.c_str());
+
+      WaveletUnstructuredProceduralVolume reference(
+          vec3i(32), vec3f(0.f), vec3f(1.f), cellType, false);
+
+      WaveletUnstructuredProceduralVolume writer(
+          vec3i(32), vec3f(0.f), vec3f(1.f), cellType, false);
+      commitWithCache(writer, filename);
+
+      REQUIRE(fileExists(filename));
+
+      WaveletUnstructuredProceduralVolume reader(
+          vec3i(32), vec3f(0.f), vec3f(1.f), cellType, false);
+      commitWithCache(reader, filename);
+
+      requireMatchingAccelerators(reader.getVKLVolume(),
+                                  reference.getVKLVolume());
+    }
+  }
+
+  SECTION("caches written for other inputs are replaced")
+  {
+    XYZStructuredRegularVolume<float> other(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+    commitWithCache(other, filename);
+
+    WaveletStructuredRegularVolume<float> reference(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+
+    WaveletStructuredRegularVolume<float> volume(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+    commitWithCache(volume, filename);
+
+    requireMatchingAccelerators(volume.getVKLVolume(),
+                                reference.getVKLVolume());
+
+    // the cache now matches the second volume
+    WaveletStructuredRegularVolume<float> reader(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+    commitWithCache(reader, filename);
+
+    requireMatchingAccelerators(reader.getVKLVolume(),
+                                reference.getVKLVolume());
+  }
+
+  SECTION("unwritable cache files do not affect the volume")
+  {
+    WaveletStructuredRegularVolume<float> reference(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+
+    WaveletStructuredRegularVolume<float> volume(
+        vec3i(128), vec3f(0.f), vec3f(1.f));
+    commitWithCache(volume, "nonexistent_directory/accelerator_cache.bin");
+
+    REQUIRE(vklDriverGetLastErrorCode(driver) == VKL_NO_ERROR);
+    requireMatchingAccelerators(volume.getVKLVolume(),
+                                reference.getVKLVolume());
+  }
+
+  std::remove(filename.c_str());
+}
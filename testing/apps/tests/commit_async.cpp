@@ -0,0 +1,134 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+TEST_CASE("Asynchronous commit", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const vec3i dimensions(67, 45, 33);
+  const vec3f gridOrigin(-1.f, 2.f, 0.5f);
+  const vec3f gridSpacing(0.1f, 0.2f, 0.15f);
+
+  const int numVolumes = 4;
+
+  std::vector<std::vector<float>> volumesVoxels;
+
+  for (int i = 0; i < numVolumes; i++) {
+    volumesVoxels.push_back(generateSmoothVoxels(dimensions, i));
+  }
+
+  auto createVolume = [&](const std::vector<float> &voxels) {
+    return newStructuredRegularVolume(
+        dimensions, gridOrigin, gridSpacing, VKL_FLOAT, voxels.data());
+  };
+
+  std::vector<VKLVolume> references;
+
+  for (const std::vector<float> &voxels : volumesVoxels) {
+    references.push_back(createVolume(voxels));
+    vklCommit(references.back());
+  }
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  // includes coordinates outside the volume
+  std::uniform_real_distribution<float> distX(-1.5f, 6.f);
+  std::uniform_real_distribution<float> distY(1.5f, 11.f);
+  std::uniform_real_distribution<float> distZ(0.f, 5.5f);
+
+  std::vector<vkl_vec3f> objectCoordinates(1000);
+
+  for (vkl_vec3f &oc : objectCoordinates) {
+    oc = vkl_vec3f{distX(eng), distY(eng), distZ(eng)};
+  }
+
+  auto requireMatchingVolumes = [&](VKLVolume volume, VKLVolume reference) {
+    REQUIRE(vklGetValueRange(volume).lower ==
+            vklGetValueRange(reference).lower);
+    REQUIRE(vklGetValueRange(volume).upper ==
+            vklGetValueRange(reference).upper);
+
+    for (const vkl_vec3f &oc : objectCoordinates) {
+      INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+      const float referenceSample = vklComputeSample(reference, &oc);
+      const float sample          = vklComputeSample(volume, &oc);
+
+      if (std::isnan(referenceSample)) {
+        REQUIRE(std::isnan(sample));
+      } else {
+        REQUIRE(sample == referenceSample);
+      }
+    }
+  };
+
+  SECTION("concurrent commits of multiple volumes")
+  {
+    std::vector<VKLVolume> volumes;
+    std::vector<VKLFuture> futures;
+
+    for (const std::vector<float> &voxels : volumesVoxels) {
+      volumes.push_back(createVolume(voxels));
+      futures.push_back(vklCommitAsync(volumes.back()));
+    }
+
+    for (int i = 0; i < numVolumes; i++) {
+      vklWait(futures[i]);
+      REQUIRE(vklIsReady(futures[i]));
+
+      vklRelease(futures[i]);
+
+      requireMatchingVolumes(volumes[i], references[i]);
+      vklRelease(volumes[i]);
+    }
+
+    REQUIRE(vklDriverGetLastErrorCode(driver) == VKL_NO_ERROR);
+  }
+
+  SECTION("volumes may be released before the commit completes")
+  {
+    VKLVolume volume = createVolume(volumesVoxels[0]);
+
+    VKLFuture future = vklCommitAsync(volume);
+    vklRelease(volume);
+
+    vklWait(future);
+    vklRelease(future);
+
+    REQUIRE(vklDriverGetLastErrorCode(driver) == VKL_NO_ERROR);
+  }
+
+  SECTION("commit errors are reported on wait")
+  {
+    // no data
+    VKLVolume volume = vklNewVolume("structuredRegular");
+    vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+    VKLFuture future = vklCommitAsync(volume);
+    REQUIRE(future != nullptr);
+
+    vklWait(future);
+    REQUIRE(vklDriverGetLastErrorCode(driver) != VKL_NO_ERROR);
+
+    vklRelease(future);
+    vklRelease(volume);
+  }
+
+  for (VKLVolume reference : references) {
+    vklRelease(reference);
+  }
+}
@@ -0,0 +1,95 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+TEST_CASE("Data from file", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const std::string filename = "vklTests_data_from_file.raw";
+
+  const vec3i dimensions(67, 45, 33);
+
+  const std::vector<float> voxels = generateSmoothVoxels(dimensions);
+
+  // voxels follow a header which is not a multiple of the page size
+  const size_t offset = 100;
+
+  {
+    std::ofstream output(filename, std::ios::binary);
+    const std::vector<char> header(offset, 0);
+    output.write(header.data(), header.size());
+    output.write((const char *)voxels.data(), voxels.size() * sizeof(float));
+  }
+
+  SECTION("mapped data matches copied data")
+  {
+    VKLData mappedData = vklNewDataFromFile(
+        filename.c_str(), offset, dimensions.long_product(), VKL_FLOAT);
+
+    REQUIRE(mappedData != nullptr);
+
+    VKLVolume volume = newStructuredRegularVolume(
+        dimensions, vec3f(0.f), vec3f(1.f), mappedData);
+    vklRelease(mappedData);
+    vklCommit(volume);
+
+    VKLVolume reference = newStructuredRegularVolume(
+        dimensions, vec3f(0.f), vec3f(1.f), VKL_FLOAT, voxels.data());
+    vklCommit(reference);
+
+    const vkl_range1f valueRange          = vklGetValueRange(volume);
+    const vkl_range1f referenceValueRange = vklGetValueRange(reference);
+
+    REQUIRE(valueRange.lower == referenceValueRange.lower);
+    REQUIRE(valueRange.upper == referenceValueRange.upper);
+
+    vkl_box3f bbox = vklGetBoundingBox(volume);
+
+    std::random_device rd;
+    std::mt19937 eng(rd());
+
+    std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+    std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+    std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+    for (size_t i = 0; i < 1000; i++) {
+      const vkl_vec3f oc{distX(eng), distY(eng), distZ(eng)};
+
+      INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+      REQUIRE(vklComputeSample(volume, &oc) ==
+              vklComputeSample(reference, &oc));
+    }
+
+    vklRelease(volume);
+    vklRelease(reference);
+  }
+
+  SECTION("invalid files and ranges")
+  {
+    // errors are reported through the driver error callback
+    REQUIRE(vklNewDataFromFile("nonexistent_file.raw", 0, 1, VKL_FLOAT) ==
+            nullptr);
+
+    REQUIRE(vklNewDataFromFile(filename.c_str(),
+                               offset + 1,
+                               dimensions.long_product(),
+                               VKL_FLOAT) == nullptr);
+  }
+
+  std::remove(filename.c_str());
+}
@@ -169,6 +169,71 @@ void scalar_interval_value_ranges_with_value_selector(VKLVolume volume)
   vklRelease(valueSelector);
 }
 
+// intervals returned with a value selector must match the intervals returned
+// without one, restricted to those overlapping the value selector ranges. this
+// holds regardless of which regions the iterator skips internally.
+void scalar_interval_value_selector_matches_filtered_intervals(
+    VKLVolume volume,
+    const vkl_vec3f &origin,
+    const vkl_vec3f &direction,
+    const std::vector<vkl_range1f> &valueRanges)
+{
+  vkl_range1f tRange{0.f, inf};
+
+  INFO("origin = " << origin.x << " " << origin.y << " " << origin.z
+                   << " direction = " << direction.x << " " << direction.y
+                   << " " << direction.z);
+
+  std::vector<VKLInterval> expectedIntervals;
+
+  VKLIntervalIterator iterator;
+  vklInitIntervalIterator(
+      &iterator, volume, &origin, &direction, &tRange, nullptr);
+
+  VKLInterval interval;
+
+  while (vklIterateInterval(&iterator, &interval)) {
+    for (const auto &r : valueRanges) {
+      if (rangesIntersect(r, interval.valueRange)) {
+        expectedIntervals.push_back(interval);
+        break;
+      }
+    }
+  }
+
+  VKLValueSelector valueSelector = vklNewValueSelector(volume);
+  vklValueSelectorSetRanges(
+      valueSelector, valueRanges.size(), valueRanges.data());
+  vklCommit(valueSelector);
+
+  vklInitIntervalIterator(
+      &iterator, volume, &origin, &direction, &tRange, valueSelector);
+
+  size_t intervalCount = 0;
+
+  while (vklIterateInterval(&iterator, &interval)) {
+    REQUIRE(intervalCount < expectedIntervals.size());
+
+    const VKLInterval &expected = expectedIntervals[intervalCount];
+
+    INFO("interval tRange = " << interval.tRange.lower << ", "
+                              << interval.tRange.upper << " expected = "
+                              << expected.tRange.lower << ", "
+                              << expected.tRange.upper);
+
+    REQUIRE(interval.tRange.lower == expected.tRange.lower);
+    REQUIRE(interval.tRange.upper == expected.tRange.upper);
+    REQUIRE(interval.valueRange.lower == expected.valueRange.lower);
+    REQUIRE(interval.valueRange.upper == expected.valueRange.upper);
+
+    intervalCount++;
+  }
+
+  REQUIRE(intervalCount == expectedIntervals.size());
+
+  vklRelease(valueSelector);
+}
+
 void scalar_interval_nominalDeltaT(VKLVolume volume,
                                    const vec3f &direction,
                                    const float expectedNominalDeltaT)
@@ -240,6 +305,74 @@ TEST_CASE("Interval iterator", "[interval_iterators]")
     }
   }
 
+  SECTION("structured volumes: macrocell widths")
+  {
+    // for a unit cube physical grid [(0,0,0), (1,1,1)]
+    const vec3i dimensions(128);
+    const vec3f gridOrigin(0.f);
+    const vec3f gridSpacing(1.f / (128.f - 1.f));
+
+    auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+        dimensions, gridOrigin, gridSpacing);
+
+    VKLVolume vklVolume = v->getVKLVolume();
+
+    const vkl_range1f valueRange = vklGetValueRange(vklVolume);
+
+    for (int macrocellWidth : {2, 4, 8, 32, 64, 128}) {
+      INFO("macrocellWidth = " << macrocellWidth);
+
+      vklSetInt(vklVolume, "macrocellWidth", macrocellWidth);
+      vklCommit(vklVolume);
+
+      // the volume value range is independent of the macrocell width
+      const vkl_range1f macrocellValueRange = vklGetValueRange(vklVolume);
+
+      REQUIRE(macrocellValueRange.lower == valueRange.lower);
+      REQUIRE(macrocellValueRange.upper == valueRange.upper);
+
+      scalar_interval_continuity_with_no_value_selector(vklVolume);
+      scalar_interval_value_ranges_with_no_value_selector(vklVolume);
+    }
+  }
+
+  SECTION("structured volumes: empty space skipping")
+  {
+    // for a unit cube physical grid [(0,0,0), (1,1,1)]
+    const vec3i dimensions(128);
+    const vec3f gridOrigin(0.f);
+    const vec3f gridSpacing(1.f / (128.f - 1.f));
+
+    // values x*y*z, so that most of the volume is outside the value selector
+    // ranges below
+    auto v = ospcommon::make_unique<XYZStructuredRegularVolume<float>>(
+        dimensions, gridOrigin, gridSpacing);
+
+    VKLVolume vklVolume = v->getVKLVolume();
+
+    const std::vector<vkl_range1f> valueRanges{{0.f, 0.001f}, {0.9f, 1.f}};
+
+    // small macrocells lead to the deepest value range hierarchy
+    for (int macrocellWidth : {2, 16}) {
+      INFO("macrocellWidth = " << macrocellWidth);
+
+      vklSetInt(vklVolume, "macrocellWidth", macrocellWidth);
+      vklCommit(vklVolume);
+
+      scalar_interval_value_selector_matches_filtered_intervals(
+          vklVolume, {0.5f, 0.5f, -1.f}, {0.f, 0.f, 1.f}, valueRanges);
+
+      scalar_interval_value_selector_matches_filtered_intervals(
+          vklVolume, {-1.f, -0.9f, -1.1f}, {1.f, 1.f, 1.f}, valueRanges);
+
+      scalar_interval_value_selector_matches_filtered_intervals(
+          vklVolume, {2.f, 2.1f, 1.9f}, {-1.f, -1.f, -1.f}, valueRanges);
+
+      scalar_interval_value_selector_matches_filtered_intervals(
+          vklVolume, {-0.1f, 0.2f, 1.1f}, {1.f, 0.7f, -0.9f}, valueRanges);
+    }
+  }
+
   SECTION("structured volumes: interval nominalDeltaT")
   {
     // use a different volume to facilitate nominalDeltaT tests
@@ -0,0 +1,153 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+template <typename VOLUME_TYPE>
+void test_stream_sampling()
+{
+  auto v =
+      ospcommon::make_unique<VOLUME_TYPE>(vec3i(128), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  // cover empty, partial packet, and multi-chunk (parallel) stream lengths
+  std::vector<unsigned int> streamLengths{0, 1, 7, 16, 33, 1000, 100000};
+
+  for (auto N : streamLengths) {
+    std::vector<vec3f> objectCoordinates(N);
+    std::vector<float> x(N), y(N), z(N);
+
+    for (unsigned int i = 0; i < N; i++) {
+      objectCoordinates[i] = vec3f(distX(eng), distY(eng), distZ(eng));
+
+      x[i] = objectCoordinates[i].x;
+      y[i] = objectCoordinates[i].y;
+      z[i] = objectCoordinates[i].z;
+    }
+
+    std::vector<float> samplesAOS(N);
+    std::vector<float> samplesSOA(N);
+
+    vklComputeSampleN(vklVolume,
+                      N,
+                      (const vkl_vec3f *)objectCoordinates.data(),
+                      samplesAOS.data());
+
+    vklComputeSampleNSOA(
+        vklVolume, N, x.data(), y.data(), z.data(), samplesSOA.data());
+
+    for (unsigned int i = 0; i < N; i++) {
+      float sampleTruth = vklComputeSample(
+          vklVolume, (const vkl_vec3f *)&objectCoordinates[i]);
+
+      INFO("sample = " << i + 1 << " / " << N);
+      REQUIRE(sampleTruth == samplesAOS[i]);
+      REQUIRE(sampleTruth == samplesSOA[i]);
+    }
+  }
+}
+
+void test_stream_sample_and_gradient(VKLVolume volume)
+{
+  vkl_box3f bbox = vklGetBoundingBox(volume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  std::vector<unsigned int> streamLengths{0, 1, 7, 16, 33, 1000, 100000};
+
+  for (auto N : streamLengths) {
+    std::vector<vec3f> objectCoordinates(N);
+
+    for (auto &oc : objectCoordinates) {
+      oc = vec3f(distX(eng), distY(eng), distZ(eng));
+    }
+
+    std::vector<float> samples(N);
+    std::vector<vec3f> gradients(N);
+
+    vklComputeSampleAndGradientN(volume,
+                                 N,
+                                 (const vkl_vec3f *)objectCoordinates.data(),
+                                 samples.data(),
+                                 (vkl_vec3f *)gradients.data());
+
+    for (unsigned int i = 0; i < N; i++) {
+      float sampleTruth =
+          vklComputeSample(volume, (const vkl_vec3f *)&objectCoordinates[i]);
+      vkl_vec3f gradientTruth =
+          vklComputeGradient(volume, (const vkl_vec3f *)&objectCoordinates[i]);
+
+      INFO("sample = " << i + 1 << " / " << N);
+      REQUIRE(sampleTruth == samples[i]);
+      REQUIRE(gradientTruth.x == gradients[i].x);
+      REQUIRE(gradientTruth.y == gradients[i].y);
+      REQUIRE(gradientTruth.z == gradients[i].z);
+    }
+  }
+}
+
+TEST_CASE("Stream sampling", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  SECTION("structured")
+  {
+    test_stream_sampling<WaveletStructuredRegularVolume<float>>();
+  }
+
+  SECTION("unstructured")
+  {
+    test_stream_sampling<WaveletUnstructuredProceduralVolume>();
+  }
+}
+
+TEST_CASE("Stream sample and gradient", "[volume_gradients]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  SECTION("structured")
+  {
+    std::unique_ptr<XYZStructuredRegularVolume<float>> v(
+        new XYZStructuredRegularVolume<float>(
+            vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+    test_stream_sample_and_gradient(v->getVKLVolume());
+  }
+
+  SECTION("unstructured")
+  {
+    std::unique_ptr<XYZUnstructuredProceduralVolume> v(
+        new XYZUnstructuredProceduralVolume(
+            vec3i(128), vec3f(0.f), vec3f(1.f), VKL_HEXAHEDRON, false));
+
+    test_stream_sample_and_gradient(v->getVKLVolume());
+  }
+}
@@ -0,0 +1,99 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+// samples of the compressed volume must be within the quantization error of
+// the uncompressed volume, which is bounded by half a quantization step over
+// the full value range
+template <typename VOXEL_TYPE>
+void test_compressed_vs_uncompressed(const vec3i &dimensions)
+{
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<VOXEL_TYPE>>(
+      dimensions, vec3f(0.f), vec3f(1.f));
+
+  VKLVolume volume = v->getVKLVolume();
+
+  std::vector<unsigned char> voxels = v->generateVoxels();
+
+  VKLVolume compressedVolume = vklNewVolume("structuredRegularCompressed");
+
+  vklSetVec3i(compressedVolume,
+              "dimensions",
+              dimensions.x,
+              dimensions.y,
+              dimensions.z);
+
+  VKLData data = vklNewData(dimensions.long_product(),
+                            getVKLDataType<VOXEL_TYPE>(),
+                            voxels.data());
+  vklSetData(compressedVolume, "data", data);
+  vklRelease(data);
+
+  vklCommit(compressedVolume);
+
+  const vkl_range1f valueRange = vklGetValueRange(volume);
+  const vkl_range1f compressedValueRange = vklGetValueRange(compressedVolume);
+
+  const float tolerance =
+      0.5f * (valueRange.upper - valueRange.lower) / 255.f * 1.01f;
+
+  // the lower bound of each brick is represented exactly
+  REQUIRE(compressedValueRange.lower == valueRange.lower);
+  REQUIRE(compressedValueRange.upper == Approx(valueRange.upper));
+
+  vkl_box3f bbox = vklGetBoundingBox(volume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  for (size_t i = 0; i < 10000; i++) {
+    const vec3f oc(distX(eng), distY(eng), distZ(eng));
+
+    INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+    const float sample = vklComputeSample(volume, (const vkl_vec3f *)&oc);
+    const float compressedSample =
+        vklComputeSample(compressedVolume, (const vkl_vec3f *)&oc);
+
+    REQUIRE(std::abs(compressedSample - sample) <= tolerance);
+  }
+
+  vklRelease(compressedVolume);
+}
+
+TEST_CASE("Structured regular compressed volume", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  // dimensions which are not multiples of the brick width
+  const vec3i dimensions(67, 45, 33);
+
+  SECTION("unsigned char")
+  {
+    test_compressed_vs_uncompressed<unsigned char>(dimensions);
+  }
+
+  SECTION("float")
+  {
+    test_compressed_vs_uncompressed<float>(dimensions);
+  }
+
+  SECTION("double")
+  {
+    test_compressed_vs_uncompressed<double>(dimensions);
+  }
+}
@@ -0,0 +1,162 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+// the bricked and Morton layouts must give results identical to the linear
+// layout
+template <typename PROCEDURAL_VOLUME_TYPE>
+void test_layout_vs_linear_layout(VKLStructuredLayout layout,
+                                  const vec3i &dimensions)
+{
+  auto v = ospcommon::make_unique<PROCEDURAL_VOLUME_TYPE>(
+      dimensions, vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  const size_t numSamples = 10000;
+
+  std::vector<vec3f> objectCoordinates(numSamples);
+
+  for (auto &oc : objectCoordinates) {
+    oc = vec3f(distX(eng), distY(eng), distZ(eng));
+  }
+
+  // include the upper bounding box corner, which touches the last (partial)
+  // brick in each dimension
+  objectCoordinates.push_back(vec3f(bbox.upper.x, bbox.upper.y, bbox.upper.z));
+
+  std::vector<float> samplesLinear;
+  std::vector<vkl_vec3f> gradientsLinear;
+
+  for (const auto &oc : objectCoordinates) {
+    samplesLinear.push_back(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&oc));
+    gradientsLinear.push_back(
+        vklComputeGradient(vklVolume, (const vkl_vec3f *)&oc));
+  }
+
+  const vkl_range1f valueRangeLinear = vklGetValueRange(vklVolume);
+
+  vklSetInt(vklVolume, "layout", layout);
+  vklCommit(vklVolume);
+
+  const vkl_range1f valueRange = vklGetValueRange(vklVolume);
+
+  REQUIRE(valueRangeLinear.lower == valueRange.lower);
+  REQUIRE(valueRangeLinear.upper == valueRange.upper);
+
+  for (size_t i = 0; i < objectCoordinates.size(); i++) {
+    const vkl_vec3f *oc = (const vkl_vec3f *)&objectCoordinates[i];
+
+    const float sample       = vklComputeSample(vklVolume, oc);
+    const vkl_vec3f gradient = vklComputeGradient(vklVolume, oc);
+
+    INFO("objectCoordinates = " << objectCoordinates[i].x << " "
+                                << objectCoordinates[i].y << " "
+                                << objectCoordinates[i].z);
+
+    REQUIRE(sample == samplesLinear[i]);
+    REQUIRE(gradient.x == gradientsLinear[i].x);
+    REQUIRE(gradient.y == gradientsLinear[i].y);
+    REQUIRE(gradient.z == gradientsLinear[i].z);
+  }
+}
+
+TEST_CASE("Structured regular volume bricked layout", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  // dimensions which are not multiples of the brick width
+  const vec3i dimensions(67, 45, 33);
+
+  SECTION("unsigned char")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeUChar>(
+        VKL_STRUCTURED_LAYOUT_BRICKED, dimensions);
+  }
+
+  SECTION("short")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeShort>(
+        VKL_STRUCTURED_LAYOUT_BRICKED, dimensions);
+  }
+
+  SECTION("unsigned short")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeUShort>(
+        VKL_STRUCTURED_LAYOUT_BRICKED, dimensions);
+  }
+
+  SECTION("float")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeFloat>(
+        VKL_STRUCTURED_LAYOUT_BRICKED, dimensions);
+  }
+
+  SECTION("double")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeDouble>(
+        VKL_STRUCTURED_LAYOUT_BRICKED, dimensions);
+  }
+}
+
+TEST_CASE("Structured regular volume Morton layout", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  // dimensions which are not multiples of the Morton brick width
+  const vec3i dimensions(67, 45, 33);
+
+  SECTION("unsigned char")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeUChar>(
+        VKL_STRUCTURED_LAYOUT_MORTON, dimensions);
+  }
+
+  SECTION("short")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeShort>(
+        VKL_STRUCTURED_LAYOUT_MORTON, dimensions);
+  }
+
+  SECTION("unsigned short")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeUShort>(
+        VKL_STRUCTURED_LAYOUT_MORTON, dimensions);
+  }
+
+  SECTION("float")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeFloat>(
+        VKL_STRUCTURED_LAYOUT_MORTON, dimensions);
+  }
+
+  SECTION("double")
+  {
+    test_layout_vs_linear_layout<WaveletStructuredRegularVolumeDouble>(
+        VKL_STRUCTURED_LAYOUT_MORTON, dimensions);
+  }
+}
@@ -0,0 +1,225 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+struct InMemoryVoxels
+{
+  vec3i dimensions;
+  std::vector<float> voxels;
+};
+
+static void loadVoxels(void *userData, const vkl_box3i *region, float *voxels)
+{
+  const InMemoryVoxels &source = *static_cast<const InMemoryVoxels *>(userData);
+  const vec3i &dimensions      = source.dimensions;
+
+  for (int z = region->lower.z; z <= region->upper.z; z++) {
+    for (int y = region->lower.y; y <= region->upper.y; y++) {
+      for (int x = region->lower.x; x <= region->upper.x; x++) {
+        *voxels++ =
+            source.voxels[x + dimensions.x * (y + size_t(dimensions.y) * z)];
+      }
+    }
+  }
+}
+
+// returns hits, misses and evictions of the brick cache
+static std::vector<uint64_t> getBrickCacheStatistics(VKLObserver observer)
+{
+  REQUIRE(vklGetObserverElementType(observer) == VKL_ULONG);
+  REQUIRE(vklGetObserverNumElements(observer) == 3);
+
+  const uint64_t *statistics =
+      static_cast<const uint64_t *>(vklMapObserver(observer));
+  std::vector<uint64_t> result(statistics, statistics + 3);
+  vklUnmapObserver(observer);
+
+  return result;
+}
+
+static void requireMatchingSamples(VKLVolume volume, VKLVolume reference)
+{
+  const vkl_range1f valueRange          = vklGetValueRange(volume);
+  const vkl_range1f referenceValueRange = vklGetValueRange(reference);
+
+  REQUIRE(valueRange.lower == referenceValueRange.lower);
+  REQUIRE(valueRange.upper == referenceValueRange.upper);
+
+  vkl_box3f bbox = vklGetBoundingBox(volume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const vkl_vec3f oc{distX(eng), distY(eng), distZ(eng)};
+
+    INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+    REQUIRE(vklComputeSample(volume, &oc) ==
+            Approx(vklComputeSample(reference, &oc)).margin(1e-5f));
+  }
+}
+
+TEST_CASE("Structured regular out-of-core volume", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  // partial bricks in all dimensions
+  InMemoryVoxels source;
+  source.dimensions = vec3i(131, 70, 66);
+
+  for (int z = 0; z < source.dimensions.z; z++) {
+    for (int y = 0; y < source.dimensions.y; y++) {
+      for (int x = 0; x < source.dimensions.x; x++) {
+        source.voxels.push_back(std::sin(0.1f * x) + std::cos(0.2f * y) +
+                                0.01f * z);
+      }
+    }
+  }
+
+  const vec3i &dimensions = source.dimensions;
+
+  VKLVolume reference = vklNewVolume("structuredRegular");
+  vklSetVec3i(
+      reference, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  VKLData data = vklNewData(
+      source.voxels.size(), VKL_FLOAT, source.voxels.data(), VKL_DATA_DEFAULT);
+  vklSetData(reference, "data", data);
+  vklRelease(data);
+
+  vklCommit(reference);
+
+  VKLVolume volume = vklNewVolume("structuredRegularOutOfCore");
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  SECTION("file source")
+  {
+    const std::string filename = "vklTests_out_of_core.raw";
+
+    // voxels follow a header
+    const size_t offset = 100;
+
+    {
+      std::ofstream output(filename, std::ios::binary);
+      const std::vector<char> header(offset, 0);
+      output.write(header.data(), header.size());
+      output.write((const char *)source.voxels.data(),
+                   source.voxels.size() * sizeof(float));
+    }
+
+    vklSetString(volume, "filename", filename.c_str());
+    vklSetSize(volume, "fileOffset", offset);
+    vklSetInt(volume, "voxelType", VKL_FLOAT);
+    vklCommit(volume);
+
+    requireMatchingSamples(volume, reference);
+
+    std::remove(filename.c_str());
+  }
+
+  SECTION("file source, with an offset beyond 2GB")
+  {
+    const std::string filename = "vklTests_out_of_core_large_offset.raw";
+
+    // the header is skipped rather than written, so that file systems with
+    // sparse files do not need to allocate it
+    const size_t offset = (size_t(3) << 30) + 100;
+
+    {
+      std::ofstream output(filename, std::ios::binary);
+      output.seekp(offset);
+      output.write((const char *)source.voxels.data(),
+                   source.voxels.size() * sizeof(float));
+      REQUIRE(output.good());
+    }
+
+    vklSetString(volume, "filename", filename.c_str());
+    vklSetSize(volume, "fileOffset", offset);
+    vklSetInt(volume, "voxelType", VKL_FLOAT);
+    vklCommit(volume);
+
+    requireMatchingSamples(volume, reference);
+
+    std::remove(filename.c_str());
+  }
+
+  SECTION("callback source, with evictions")
+  {
+    vklSetVoidPtr(volume, "loadVoxelsFunction", (void *)loadVoxels);
+    vklSetVoidPtr(volume, "loadVoxelsUserData", &source);
+
+    // the volume has 3 x 2 x 2 bricks
+    vklSetInt(volume, "maxCachedBricks", 2);
+    vklCommit(volume);
+
+    requireMatchingSamples(volume, reference);
+
+    VKLObserver observer = vklNewObserver(volume, "BrickCacheStatistics");
+    REQUIRE(observer);
+
+    const std::vector<uint64_t> statistics = getBrickCacheStatistics(observer);
+
+    REQUIRE(statistics[0] > 0);
+    REQUIRE(statistics[1] >= 12);
+    REQUIRE(statistics[2] == statistics[1] - 2);
+
+    vklRelease(observer);
+  }
+
+  SECTION("empty space skipping does not access bricks")
+  {
+    vklSetVoidPtr(volume, "loadVoxelsFunction", (void *)loadVoxels);
+    vklSetVoidPtr(volume, "loadVoxelsUserData", &source);
+    vklCommit(volume);
+
+    VKLObserver observer = vklNewObserver(volume, "BrickCacheStatistics");
+    REQUIRE(observer);
+
+    const std::vector<uint64_t> statistics = getBrickCacheStatistics(observer);
+
+    // no voxels have values in this range
+    const vkl_range1f valueRange{10.f, 20.f};
+
+    VKLValueSelector valueSelector = vklNewValueSelector(volume);
+    vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+    vklCommit(valueSelector);
+
+    const vkl_vec3f origin{-1.f, 35.f, 33.f};
+    const vkl_vec3f direction{1.f, 0.f, 0.f};
+    const vkl_range1f tRange{0.f, inf};
+
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(
+        &iterator, volume, &origin, &direction, &tRange, valueSelector);
+
+    VKLInterval interval;
+    REQUIRE(!vklIterateInterval(&iterator, &interval));
+
+    vklRelease(valueSelector);
+
+    REQUIRE(getBrickCacheStatistics(observer) == statistics);
+
+    vklRelease(observer);
+  }
+
+  vklRelease(volume);
+  vklRelease(reference);
+}
@@ -132,3 +132,50 @@ TEST_CASE("Structured regular volume sampling", "[volume_sampling]")
     }
   }
 }
+
+TEST_CASE("Structured regular volume tricubic sampling", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const vec3i dimensions(16);
+
+  auto v = ospcommon::make_unique<XYZStructuredRegularVolume<float>>(
+      dimensions, vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetInt(vklVolume, "filter", VKL_FILTER_TRICUBIC);
+  vklCommit(vklVolume);
+
+  // the cubic B-spline reproduces the (per-dimension linear) XYZ field
+  // exactly, away from the volume boundary where voxel indices are clamped
+  multidim_index_sequence<3> mis(dimensions - 3);
+
+  for (const auto &offset : mis) {
+    const vec3f objectCoordinates = v->transformLocalToObjectCoordinates(
+        vec3f(offset + 1) + vec3f(0.25f, 0.5f, 0.75f));
+
+    const float proceduralValue = v->computeProceduralValue(objectCoordinates);
+    const vec3f proceduralGradient =
+        v->computeProceduralGradient(objectCoordinates);
+
+    INFO("offset = " << offset.x << " " << offset.y << " " << offset.z);
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    test_scalar_and_vector_sampling(
+        vklVolume, objectCoordinates, proceduralValue, 1e-2f);
+
+    const vkl_vec3f gradient =
+        vklComputeGradient(vklVolume, (const vkl_vec3f *)&objectCoordinates);
+
+    REQUIRE(gradient.x == Approx(proceduralGradient.x).margin(1e-2f));
+    REQUIRE(gradient.y == Approx(proceduralGradient.y).margin(1e-2f));
+    REQUIRE(gradient.z == Approx(proceduralGradient.z).margin(1e-2f));
+  }
+}
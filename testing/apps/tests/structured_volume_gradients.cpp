@@ -1,6 +1,7 @@
 // Copyright 2019 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <random>
 #include "../../external/catch.hpp"
 #include "openvkl_testing.h"
 #include "ospcommon/math/box.h"
@@ -59,6 +60,56 @@ void scalar_gradients(float tolerance = 0.1f, bool skipBoundaries = false)
   }
 }
 
+// the trilinear interpolant of the XYZ volume is exact, so that all gradient
+// methods should match the procedural gradient anywhere in the volume
+void random_gradients_xyz_regular(VKLGradientMethod gradientMethod)
+{
+  const vec3i dimensions(128);
+  const float boundingBoxSize = 2.f;
+
+  vec3f gridOrigin;
+  vec3f gridSpacing;
+
+  XYZStructuredRegularVolume<float>::generateGridParameters(
+      dimensions, boundingBoxSize, gridOrigin, gridSpacing);
+
+  auto v = ospcommon::make_unique<XYZStructuredRegularVolume<float>>(
+      dimensions, gridOrigin, gridSpacing);
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetInt(vklVolume, "gradientMethod", gradientMethod);
+  vklCommit(vklVolume);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  for (int i = 0; i < 10000; i++) {
+    const vec3f objectCoordinates(distX(eng), distY(eng), distZ(eng));
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    const vkl_vec3f vklGradient =
+        vklComputeGradient(vklVolume, (const vkl_vec3f *)&objectCoordinates);
+    const vec3f gradient = (const vec3f &)vklGradient;
+
+    const vec3f proceduralGradient =
+        v->computeProceduralGradient(objectCoordinates);
+
+    REQUIRE(gradient.x == Approx(proceduralGradient.x).margin(1e-3f));
+    REQUIRE(gradient.y == Approx(proceduralGradient.y).margin(1e-3f));
+    REQUIRE(gradient.z == Approx(proceduralGradient.z).margin(1e-3f));
+  }
+}
+
 TEST_CASE("Structured volume gradients", "[volume_gradients]")
 {
   vklLoadModule("ispc_driver");
@@ -82,3 +133,27 @@ TEST_CASE("Structured volume gradients", "[volume_gradients]")
     scalar_gradients<XYZStructuredSphericalVolume<float>>(0.1f, true);
   }
 }
+
+TEST_CASE("Structured regular volume gradient methods", "[volume_gradients]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  SECTION("analytic")
+  {
+    random_gradients_xyz_regular(VKL_GRADIENT_ANALYTIC);
+  }
+
+  SECTION("central differences")
+  {
+    random_gradients_xyz_regular(VKL_GRADIENT_CENTRAL_DIFFERENCES);
+  }
+
+  SECTION("forward differences")
+  {
+    random_gradients_xyz_regular(VKL_GRADIENT_FORWARD_DIFFERENCES);
+  }
+}
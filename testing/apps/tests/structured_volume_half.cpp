@@ -0,0 +1,98 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+// half precision volumes must give results identical to float volumes with
+// the same (exactly representable) voxel values
+void test_half_vs_float(VKLStructuredLayout layout)
+{
+  // dimensions which are not multiples of the brick width
+  const vec3i dimensions(67, 45, 33);
+
+  std::vector<float> voxelsFloat;
+  std::vector<uint16_t> voxelsHalf;
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        // multiples of 1/16 in [-8, 8]
+        const float value = ((x + 3 * y + 7 * z) % 257) / 16.f - 8.f;
+
+        voxelsFloat.push_back(value);
+        voxelsHalf.push_back(floatToHalf(value));
+      }
+    }
+  }
+
+  auto createVolume = [&](VKLDataType voxelType, const void *voxels) {
+    VKLVolume volume = newStructuredRegularVolume(
+        dimensions, vec3f(0.f), vec3f(1.f), voxelType, voxels);
+    vklSetInt(volume, "layout", layout);
+    vklCommit(volume);
+    return volume;
+  };
+
+  VKLVolume volumeFloat = createVolume(VKL_FLOAT, voxelsFloat.data());
+  VKLVolume volumeHalf  = createVolume(VKL_HALF, voxelsHalf.data());
+
+  const vkl_range1f valueRangeFloat = vklGetValueRange(volumeFloat);
+  const vkl_range1f valueRangeHalf  = vklGetValueRange(volumeHalf);
+
+  REQUIRE(valueRangeHalf.lower == valueRangeFloat.lower);
+  REQUIRE(valueRangeHalf.upper == valueRangeFloat.upper);
+
+  vkl_box3f bbox = vklGetBoundingBox(volumeFloat);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  for (size_t i = 0; i < 10000; i++) {
+    const vec3f oc(distX(eng), distY(eng), distZ(eng));
+
+    INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+    REQUIRE(vklComputeSample(volumeHalf, (const vkl_vec3f *)&oc) ==
+            vklComputeSample(volumeFloat, (const vkl_vec3f *)&oc));
+
+    const vkl_vec3f gradientFloat =
+        vklComputeGradient(volumeFloat, (const vkl_vec3f *)&oc);
+    const vkl_vec3f gradientHalf =
+        vklComputeGradient(volumeHalf, (const vkl_vec3f *)&oc);
+
+    REQUIRE(gradientHalf.x == gradientFloat.x);
+    REQUIRE(gradientHalf.y == gradientFloat.y);
+    REQUIRE(gradientHalf.z == gradientFloat.z);
+  }
+
+  vklRelease(volumeFloat);
+  vklRelease(volumeHalf);
+}
+
+TEST_CASE("Structured regular volume half precision", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  SECTION("linear layout")
+  {
+    test_half_vs_float(VKL_STRUCTURED_LAYOUT_LINEAR);
+  }
+
+  SECTION("bricked layout")
+  {
+    test_half_vs_float(VKL_STRUCTURED_LAYOUT_BRICKED);
+  }
+}
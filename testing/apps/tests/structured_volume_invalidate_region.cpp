@@ -0,0 +1,180 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <vector>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+static std::vector<VKLInterval> getIntervals(VKLVolume volume,
+                                             const vkl_vec3f &origin,
+                                             const vkl_vec3f &direction,
+                                             const vkl_range1f &valueRange)
+{
+  VKLValueSelector valueSelector = vklNewValueSelector(volume);
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  vkl_range1f tRange{0.f, inf};
+
+  VKLIntervalIterator iterator;
+  vklInitIntervalIterator(
+      &iterator, volume, &origin, &direction, &tRange, valueSelector);
+
+  std::vector<VKLInterval> intervals;
+
+  VKLInterval interval;
+
+  while (vklIterateInterval(&iterator, &interval)) {
+    intervals.push_back(interval);
+  }
+
+  vklRelease(valueSelector);
+
+  return intervals;
+}
+
+// a volume updated through vklVolumeInvalidateRegion() must behave like a
+// volume committed from scratch with the same voxel data
+static void requireEquivalentVolumes(VKLVolume volume,
+                                     VKLVolume reference,
+                                     const vkl_range1f &selectorRange)
+{
+  const vkl_range1f valueRange          = vklGetValueRange(volume);
+  const vkl_range1f referenceValueRange = vklGetValueRange(reference);
+
+  REQUIRE(valueRange.lower == referenceValueRange.lower);
+  REQUIRE(valueRange.upper == referenceValueRange.upper);
+
+  const std::vector<vkl_vec3f> origins{
+      {1.2f, 1.1f, -1.f}, {-1.f, 1.05f, 1.15f}, {-1.f, -0.9f, -1.1f}};
+  const std::vector<vkl_vec3f> directions{
+      {0.f, 0.f, 1.f}, {1.f, 0.f, 0.f}, {1.f, 1.f, 1.f}};
+
+  for (size_t i = 0; i < origins.size(); i++) {
+    const std::vector<VKLInterval> intervals =
+        getIntervals(volume, origins[i], directions[i], selectorRange);
+    const std::vector<VKLInterval> referenceIntervals =
+        getIntervals(reference, origins[i], directions[i], selectorRange);
+
+    INFO("ray " << i);
+
+    REQUIRE(intervals.size() == referenceIntervals.size());
+
+    for (size_t j = 0; j < intervals.size(); j++) {
+      REQUIRE(intervals[j].tRange.lower == referenceIntervals[j].tRange.lower);
+      REQUIRE(intervals[j].tRange.upper == referenceIntervals[j].tRange.upper);
+      REQUIRE(intervals[j].valueRange.lower ==
+              referenceIntervals[j].valueRange.lower);
+      REQUIRE(intervals[j].valueRange.upper ==
+              referenceIntervals[j].valueRange.upper);
+    }
+  }
+}
+
+void test_invalidate_region(VKLFilter filter)
+{
+  // dimensions which are not multiples of the macrocell width
+  const vec3i dimensions(67, 45, 33);
+
+  std::vector<float> voxels(dimensions.long_product(), 0.f);
+
+  auto createVolume = [&](VKLDataCreationFlags dataCreationFlags) {
+    VKLVolume volume = newStructuredRegularVolume(dimensions,
+                                                  vec3f(0.f),
+                                                  vec3f(0.1f),
+                                                  VKL_FLOAT,
+                                                  voxels.data(),
+                                                  dataCreationFlags);
+    vklSetInt(volume, "filter", filter);
+    vklSetInt(volume, "macrocellWidth", 4);
+    vklCommit(volume);
+    return volume;
+  };
+
+  VKLVolume volume = createVolume(VKL_DATA_SHARED_BUFFER);
+
+  const vkl_range1f selectorRange{0.5f, 1.5f};
+
+  auto setRegion = [&](const vkl_box3i &region, float value) {
+    for (int z = region.lower.z; z <= region.upper.z; z++) {
+      for (int y = region.lower.y; y <= region.upper.y; y++) {
+        for (int x = region.lower.x; x <= region.upper.x; x++) {
+          voxels[x + dimensions.x * (y + size_t(dimensions.y) * z)] = value;
+        }
+      }
+    }
+
+    vklVolumeInvalidateRegion(volume, &region);
+  };
+
+  // volume committed from a copy of the current voxel data
+  auto createReferenceVolume = [&]() {
+    return createVolume(VKL_DATA_DEFAULT);
+  };
+
+  // regions touching macrocell boundaries, and the volume boundary
+  const std::vector<vkl_box3i> regions{{{11, 10, 12}, {12, 11, 12}},
+                                       {{16, 20, 4}, {23, 27, 7}},
+                                       {{60, 40, 30}, {66, 44, 32}}};
+
+  SECTION("setting and resetting regions")
+  {
+    for (const auto &region : regions) {
+      setRegion(region, 1.f);
+
+      VKLVolume reference = createReferenceVolume();
+      requireEquivalentVolumes(volume, reference, selectorRange);
+      vklRelease(reference);
+    }
+
+    REQUIRE(vklGetValueRange(volume).upper == 1.f);
+
+    for (const auto &region : regions) {
+      setRegion(region, 0.f);
+
+      VKLVolume reference = createReferenceVolume();
+      requireEquivalentVolumes(volume, reference, selectorRange);
+      vklRelease(reference);
+    }
+
+    REQUIRE(vklGetValueRange(volume).lower == 0.f);
+    REQUIRE(vklGetValueRange(volume).upper == 0.f);
+  }
+
+  SECTION("regions partially outside the volume")
+  {
+    setRegion({{60, 40, 30}, {66, 44, 32}}, 1.f);
+
+    // only the part within the volume is considered
+    const vkl_box3i region{{60, 40, 30}, {100, 100, 100}};
+    vklVolumeInvalidateRegion(volume, &region);
+
+    VKLVolume reference = createReferenceVolume();
+    requireEquivalentVolumes(volume, reference, selectorRange);
+    vklRelease(reference);
+  }
+
+  vklRelease(volume);
+}
+
+TEST_CASE("Structured volume invalidate region", "[volume_value_range]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  SECTION("trilinear filter")
+  {
+    test_invalidate_region(VKL_FILTER_TRILINEAR);
+  }
+
+  SECTION("tricubic filter")
+  {
+    test_invalidate_region(VKL_FILTER_TRICUBIC);
+  }
+}
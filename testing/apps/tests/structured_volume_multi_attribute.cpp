@@ -0,0 +1,236 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+// voxel values of one attribute, in any of the supported voxel types
+struct Attribute
+{
+  VKLDataType dataType;
+  std::vector<unsigned char> voxels;
+
+  VKLData newData() const
+  {
+    return vklNewData(voxels.size() / sizeOfVKLDataType(dataType),
+                      dataType,
+                      voxels.data(),
+                      VKL_DATA_DEFAULT);
+  }
+};
+
+template <typename T>
+static Attribute createAttribute(VKLDataType dataType,
+                                 const vec3i &dimensions,
+                                 float (*f)(const vec3i &index))
+{
+  Attribute attribute;
+  attribute.dataType = dataType;
+  attribute.voxels.resize(dimensions.long_product() * sizeof(T));
+
+  T *voxels = reinterpret_cast<T *>(attribute.voxels.data());
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        *voxels++ = T(f(vec3i(x, y, z)));
+      }
+    }
+  }
+
+  return attribute;
+}
+
+TEST_CASE("Structured volume multiple attributes", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const vec3i dimensions(67, 45, 33);
+  const vec3f gridOrigin(-1.f, 2.f, 0.5f);
+  const vec3f gridSpacing(0.1f, 0.2f, 0.15f);
+
+  const std::vector<Attribute> attributes{
+      createAttribute<float>(VKL_FLOAT,
+                             dimensions,
+                             [](const vec3i &i) {
+                               return std::sin(0.1f * i.x) +
+                                      std::cos(0.2f * i.y) + 0.01f * i.z;
+                             }),
+      createAttribute<uint8_t>(VKL_UCHAR,
+                               dimensions,
+                               [](const vec3i &i) {
+                                 return float((i.x * 7 + i.y * 3 + i.z) % 256);
+                               }),
+      createAttribute<double>(VKL_DOUBLE, dimensions, [](const vec3i &i) {
+        return float(i.x - 2 * i.y + 3 * i.z);
+      })};
+
+  const unsigned int numAttributes = attributes.size();
+
+  // single attribute volumes as reference
+  std::vector<VKLVolume> references;
+
+  for (const Attribute &attribute : attributes) {
+    VKLData data = attribute.newData();
+    references.push_back(
+        newStructuredRegularVolume(dimensions, gridOrigin, gridSpacing, data));
+    vklRelease(data);
+
+    vklCommit(references.back());
+  }
+
+  std::vector<VKLData> attributesData;
+
+  for (const Attribute &attribute : attributes) {
+    attributesData.push_back(attribute.newData());
+  }
+
+  VKLData data = vklNewData(
+      attributesData.size(), VKL_DATA, attributesData.data(), VKL_DATA_DEFAULT);
+
+  for (VKLData attributeData : attributesData) {
+    vklRelease(attributeData);
+  }
+
+  VKLVolume volume =
+      newStructuredRegularVolume(dimensions, gridOrigin, gridSpacing, data);
+  vklRelease(data);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  // includes coordinates outside the volume
+  std::uniform_real_distribution<float> distX(-1.5f, 6.f);
+  std::uniform_real_distribution<float> distY(1.5f, 11.f);
+  std::uniform_real_distribution<float> distZ(0.f, 5.5f);
+
+  std::vector<vkl_vec3f> objectCoordinates(5000);
+
+  for (vkl_vec3f &oc : objectCoordinates) {
+    oc = vkl_vec3f{distX(eng), distY(eng), distZ(eng)};
+  }
+
+  auto requireMatchingSample = [&](float sample,
+                                   unsigned int attributeIndex,
+                                   const vkl_vec3f &oc) {
+    INFO("attributeIndex = " << attributeIndex);
+    INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+    const float referenceSample =
+        vklComputeSample(references[attributeIndex], &oc);
+
+    if (std::isnan(referenceSample)) {
+      REQUIRE(std::isnan(sample));
+    } else {
+      REQUIRE(sample == Approx(referenceSample).margin(1e-5f));
+    }
+  };
+
+  SECTION("all attributes")
+  {
+    vklCommit(volume);
+
+    REQUIRE(vklGetNumAttributes(volume) == numAttributes);
+
+    // the first attribute is used by all other APIs
+    REQUIRE(vklGetValueRange(volume).lower ==
+            vklGetValueRange(references[0]).lower);
+    REQUIRE(vklGetValueRange(volume).upper ==
+            vklGetValueRange(references[0]).upper);
+
+    const std::vector<unsigned int> attributeIndices{0, 1, 2};
+
+    for (const vkl_vec3f &oc : objectCoordinates) {
+      REQUIRE(vklComputeSample(volume, &oc) ==
+              Approx(vklComputeSample(references[0], &oc)).margin(1e-5f));
+
+      float samples[3];
+      vklComputeSampleM(
+          volume, &oc, samples, numAttributes, attributeIndices.data());
+
+      for (unsigned int i = 0; i < numAttributes; i++) {
+        requireMatchingSample(samples[i], attributeIndices[i], oc);
+      }
+    }
+  }
+
+  SECTION("subset of attributes, streams")
+  {
+    vklCommit(volume);
+
+    // in any order, and with repetitions
+    const std::vector<unsigned int> attributeIndices{2, 0, 2};
+    const unsigned int M = attributeIndices.size();
+
+    const unsigned int N = objectCoordinates.size();
+
+    std::vector<float> samples(M * N);
+    vklComputeSampleMN(volume,
+                       N,
+                       objectCoordinates.data(),
+                       samples.data(),
+                       M,
+                       attributeIndices.data());
+
+    for (unsigned int i = 0; i < M; i++) {
+      for (unsigned int j = 0; j < N; j++) {
+        requireMatchingSample(
+            samples[i * N + j], attributeIndices[i], objectCoordinates[j]);
+      }
+    }
+  }
+
+  SECTION("single attribute volumes")
+  {
+    REQUIRE(vklGetNumAttributes(references[1]) == 1);
+
+    const unsigned int attributeIndices[2]{0, 0};
+
+    for (size_t j = 0; j < 100; j++) {
+      const vkl_vec3f &oc = objectCoordinates[j];
+
+      float samples[2];
+      vklComputeSampleM(references[1], &oc, samples, 2, attributeIndices);
+
+      requireMatchingSample(samples[0], 1, oc);
+      requireMatchingSample(samples[1], 1, oc);
+    }
+  }
+
+  SECTION("invalid attribute indices")
+  {
+    vklCommit(volume);
+
+    const unsigned int attributeIndex = numAttributes;
+
+    float sample;
+    vklComputeSampleM(
+        volume, &objectCoordinates[0], &sample, 1, &attributeIndex);
+
+    REQUIRE(vklDriverGetLastErrorCode(driver) != VKL_NO_ERROR);
+  }
+
+  SECTION("multiple attributes require the linear layout")
+  {
+    vklSetInt(volume, "layout", VKL_STRUCTURED_LAYOUT_BRICKED);
+    vklCommit(volume);
+
+    REQUIRE(vklDriverGetLastErrorCode(driver) != VKL_NO_ERROR);
+  }
+
+  vklRelease(volume);
+
+  for (VKLVolume reference : references) {
+    vklRelease(reference);
+  }
+}
@@ -0,0 +1,114 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+// on systems with a single NUMA node, replicas are not created; sampling must
+// give the same results either way
+TEST_CASE("Structured volume NUMA placement", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const vec3i dimensions(67, 45, 33);
+  const vec3f gridOrigin(-1.f, 2.f, 0.5f);
+  const vec3f gridSpacing(0.1f, 0.2f, 0.15f);
+
+  const std::vector<float> voxels = generateSmoothVoxels(dimensions);
+
+  VKLVolume reference = newStructuredRegularVolume(
+      dimensions, gridOrigin, gridSpacing, VKL_FLOAT, voxels.data());
+  vklCommit(reference);
+
+  VKLVolume volume = newStructuredRegularVolume(dimensions,
+                                                gridOrigin,
+                                                gridSpacing,
+                                                VKL_FLOAT,
+                                                voxels.data(),
+                                                VKL_DATA_NUMA_INTERLEAVED);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  // includes coordinates outside the volume
+  std::uniform_real_distribution<float> distX(-1.5f, 6.f);
+  std::uniform_real_distribution<float> distY(1.5f, 11.f);
+  std::uniform_real_distribution<float> distZ(0.f, 5.5f);
+
+  std::vector<vkl_vec3f> objectCoordinates(1000);
+
+  for (vkl_vec3f &oc : objectCoordinates) {
+    oc = vkl_vec3f{distX(eng), distY(eng), distZ(eng)};
+  }
+
+  auto requireMatchingSamples = [&]() {
+    REQUIRE(vklGetValueRange(volume).lower ==
+            vklGetValueRange(reference).lower);
+    REQUIRE(vklGetValueRange(volume).upper ==
+            vklGetValueRange(reference).upper);
+
+    for (const vkl_vec3f &oc : objectCoordinates) {
+      INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+      const float referenceSample = vklComputeSample(reference, &oc);
+      const float sample          = vklComputeSample(volume, &oc);
+
+      if (std::isnan(referenceSample)) {
+        REQUIRE(std::isnan(sample));
+      } else {
+        REQUIRE(sample == referenceSample);
+      }
+    }
+
+    std::vector<float> samples(objectCoordinates.size());
+    vklComputeSampleN(volume,
+                      objectCoordinates.size(),
+                      objectCoordinates.data(),
+                      samples.data());
+
+    for (size_t i = 0; i < objectCoordinates.size(); i++) {
+      const float referenceSample =
+          vklComputeSample(reference, &objectCoordinates[i]);
+
+      if (std::isnan(referenceSample)) {
+        REQUIRE(std::isnan(samples[i]));
+      } else {
+        REQUIRE(samples[i] == referenceSample);
+      }
+    }
+  };
+
+  SECTION("interleaved data")
+  {
+    vklCommit(volume);
+    requireMatchingSamples();
+  }
+
+  SECTION("replicas, linear layout")
+  {
+    vklSetInt(volume, "numaReplicas", 1);
+    vklCommit(volume);
+    requireMatchingSamples();
+  }
+
+  SECTION("replicas, bricked layout")
+  {
+    vklSetInt(volume, "numaReplicas", 1);
+    vklSetInt(volume, "layout", VKL_STRUCTURED_LAYOUT_BRICKED);
+    vklCommit(volume);
+    requireMatchingSamples();
+  }
+
+  vklRelease(volume);
+  vklRelease(reference);
+}
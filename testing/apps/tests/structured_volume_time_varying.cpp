@@ -0,0 +1,215 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+static std::vector<float> createTimestep(const vec3i &dimensions, float t)
+{
+  std::vector<float> voxels;
+  voxels.reserve(dimensions.long_product());
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        voxels.push_back(std::sin(0.1f * x + t) + std::cos(0.2f * y) +
+                         (0.01f + t) * z);
+      }
+    }
+  }
+
+  return voxels;
+}
+
+TEST_CASE("Structured volume time-varying sampling", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const vec3i dimensions(67, 45, 33);
+  const vec3f gridOrigin(-1.f, 2.f, 0.5f);
+  const vec3f gridSpacing(0.1f, 0.2f, 0.15f);
+
+  const unsigned int numTimesteps = 4;
+
+  std::vector<std::vector<float>> timesteps;
+
+  for (unsigned int i = 0; i < numTimesteps; i++) {
+    timesteps.push_back(createTimestep(dimensions, 0.5f * i));
+  }
+
+  // single timestep volumes as reference
+  std::vector<VKLVolume> references;
+  std::vector<VKLData> timestepsData;
+
+  for (const std::vector<float> &timestep : timesteps) {
+    VKLData data = vklNewData(
+        timestep.size(), VKL_FLOAT, timestep.data(), VKL_DATA_DEFAULT);
+
+    references.push_back(
+        newStructuredRegularVolume(dimensions, gridOrigin, gridSpacing, data));
+    vklCommit(references.back());
+
+    timestepsData.push_back(data);
+  }
+
+  VKLData timestepData = vklNewData(
+      timestepsData.size(), VKL_DATA, timestepsData.data(), VKL_DATA_DEFAULT);
+
+  VKLVolume volume =
+      newStructuredRegularVolume(dimensions, gridOrigin, gridSpacing, nullptr);
+  vklSetData(volume, "timestepData", timestepData);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  // includes coordinates outside the volume
+  std::uniform_real_distribution<float> distX(-1.5f, 6.f);
+  std::uniform_real_distribution<float> distY(1.5f, 11.f);
+  std::uniform_real_distribution<float> distZ(0.f, 5.5f);
+  std::uniform_real_distribution<float> distTime(0.f, 1.f);
+
+  std::vector<vkl_vec3f> objectCoordinates(5000);
+  std::vector<float> times(objectCoordinates.size());
+
+  for (size_t i = 0; i < objectCoordinates.size(); i++) {
+    objectCoordinates[i] = vkl_vec3f{distX(eng), distY(eng), distZ(eng)};
+    times[i]             = distTime(eng);
+  }
+
+  // linear interpolation between the reference volumes of the two adjacent
+  // timesteps
+  auto requireMatchingSample = [&](float sample,
+                                   const vkl_vec3f &oc,
+                                   float time) {
+    INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+    INFO("time = " << time);
+
+    const float timestepCoordinate =
+        std::min(std::max(time, 0.f), 1.f) * (numTimesteps - 1);
+    const unsigned int timestep0 =
+        std::min((unsigned int)timestepCoordinate, numTimesteps - 2);
+    const float timeFrac = timestepCoordinate - timestep0;
+
+    const float sample0 = vklComputeSample(references[timestep0], &oc);
+    const float sample1 = vklComputeSample(references[timestep0 + 1], &oc);
+
+    if (std::isnan(sample0)) {
+      REQUIRE(std::isnan(sample));
+    } else {
+      REQUIRE(sample ==
+              Approx((1.f - timeFrac) * sample0 + timeFrac * sample1)
+                  .margin(1e-4f));
+    }
+  };
+
+  SECTION("scalar and stream sampling")
+  {
+    vklCommit(volume);
+
+    for (size_t i = 0; i < objectCoordinates.size(); i++) {
+      requireMatchingSample(
+          vklComputeSampleAtTime(volume, &objectCoordinates[i], times[i]),
+          objectCoordinates[i],
+          times[i]);
+    }
+
+    std::vector<float> samples(objectCoordinates.size());
+    vklComputeSampleAtTimeN(volume,
+                            objectCoordinates.size(),
+                            objectCoordinates.data(),
+                            times.data(),
+                            samples.data());
+
+    for (size_t i = 0; i < objectCoordinates.size(); i++) {
+      requireMatchingSample(samples[i], objectCoordinates[i], times[i]);
+    }
+  }
+
+  SECTION("timesteps and times outside [0, 1]")
+  {
+    vklCommit(volume);
+
+    for (size_t i = 0; i < 100; i++) {
+      const vkl_vec3f &oc = objectCoordinates[i];
+
+      for (unsigned int t = 0; t < numTimesteps; t++) {
+        const float time = float(t) / (numTimesteps - 1);
+        requireMatchingSample(
+            vklComputeSampleAtTime(volume, &oc, time), oc, time);
+      }
+
+      REQUIRE(vklComputeSampleAtTime(volume, &oc, -1.f) ==
+              vklComputeSampleAtTime(volume, &oc, 0.f));
+      REQUIRE(vklComputeSampleAtTime(volume, &oc, 2.f) ==
+              vklComputeSampleAtTime(volume, &oc, 1.f));
+
+      // all other APIs sample the first timestep
+      REQUIRE(vklComputeSample(volume, &oc) ==
+              vklComputeSampleAtTime(volume, &oc, 0.f));
+    }
+  }
+
+  SECTION("value range covers all timesteps")
+  {
+    vklCommit(volume);
+
+    vkl_range1f expectedRange = vklGetValueRange(references[0]);
+
+    for (VKLVolume reference : references) {
+      const vkl_range1f range = vklGetValueRange(reference);
+      expectedRange.lower     = std::min(expectedRange.lower, range.lower);
+      expectedRange.upper     = std::max(expectedRange.upper, range.upper);
+    }
+
+    REQUIRE(vklGetValueRange(volume).lower == expectedRange.lower);
+    REQUIRE(vklGetValueRange(volume).upper == expectedRange.upper);
+  }
+
+  SECTION("volumes which do not vary over time ignore the time")
+  {
+    for (size_t i = 0; i < 100; i++) {
+      const vkl_vec3f &oc = objectCoordinates[i];
+
+      REQUIRE(vklComputeSampleAtTime(references[2], &oc, times[i]) ==
+              vklComputeSample(references[2], &oc));
+    }
+  }
+
+  SECTION("timestepData and data cannot both be set")
+  {
+    vklSetData(volume, "data", timestepsData[0]);
+    vklCommit(volume);
+
+    REQUIRE(vklDriverGetLastErrorCode(driver) != VKL_NO_ERROR);
+  }
+
+  SECTION("multiple timesteps require the linear layout")
+  {
+    vklSetInt(volume, "layout", VKL_STRUCTURED_LAYOUT_BRICKED);
+    vklCommit(volume);
+
+    REQUIRE(vklDriverGetLastErrorCode(driver) != VKL_NO_ERROR);
+  }
+
+  vklRelease(volume);
+  vklRelease(timestepData);
+
+  for (VKLData data : timestepsData) {
+    vklRelease(data);
+  }
+
+  for (VKLVolume reference : references) {
+    vklRelease(reference);
+  }
+}
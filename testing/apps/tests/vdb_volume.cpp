@@ -17,6 +17,8 @@ static void init_driver()
 }
 
 using openvkl::testing::WaveletVdbVolume;
+using openvkl::testing::floatToHalf;
+using openvkl::testing::XYZVdbVolume;
 
 TEST_CASE("VDB volume value range", "[value_range]")
 {
@@ -118,6 +120,355 @@ TEST_CASE("VDB volume sampling", "[volume_sampling]")
   }
 }
 
+TEST_CASE("VDB volume trilinear sampling", "[volume_sampling]")
+{
+  init_driver();
+
+  XYZVdbVolume *volume = nullptr;
+  REQUIRE_NOTHROW(volume = new XYZVdbVolume(
+                      32, vec3f(0.f), vec3f(1.f), VKL_FILTER_TRILINEAR));
+
+  VKLVolume vklVolume = volume->getVKLVolume();
+
+  // trilinear interpolation reproduces the XYZ field exactly; this covers
+  // stencils inside leaves as well as stencils crossing leaf boundaries
+  multidim_index_sequence<3> mis(volume->getDimensions() - 1);
+  for (const auto &offset : mis) {
+    const vec3f objectCoordinates = volume->transformLocalToObjectCoordinates(
+        vec3f(offset) + vec3f(0.25f, 0.5f, 0.75f));
+
+    const float proceduralValue =
+        volume->computeProceduralValue(objectCoordinates);
+
+    INFO("offset = " << offset.x << " " << offset.y << " " << offset.z);
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    test_scalar_and_vector_sampling(
+        vklVolume, objectCoordinates, proceduralValue, 1e-2f);
+  }
+
+  REQUIRE_NOTHROW(delete volume);
+}
+
+TEST_CASE("VDB volume tricubic sampling", "[volume_sampling]")
+{
+  init_driver();
+
+  XYZVdbVolume *volume = nullptr;
+  REQUIRE_NOTHROW(volume = new XYZVdbVolume(
+                      16, vec3f(0.f), vec3f(1.f), VKL_FILTER_TRICUBIC));
+
+  VKLVolume vklVolume = volume->getVKLVolume();
+
+  // the cubic B-spline reproduces the (per-dimension linear) XYZ field
+  // exactly, away from the volume boundary
+  multidim_index_sequence<3> mis(volume->getDimensions() - 3);
+  for (const auto &offset : mis) {
+    const vec3f objectCoordinates = volume->transformLocalToObjectCoordinates(
+        vec3f(offset + 1) + vec3f(0.25f, 0.5f, 0.75f));
+
+    const float proceduralValue =
+        volume->computeProceduralValue(objectCoordinates);
+
+    INFO("offset = " << offset.x << " " << offset.y << " " << offset.z);
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    test_scalar_and_vector_sampling(
+        vklVolume, objectCoordinates, proceduralValue, 1e-2f);
+  }
+
+  REQUIRE_NOTHROW(delete volume);
+}
+
+TEST_CASE("VDB volume gradients", "[volume_gradients]")
+{
+  init_driver();
+
+  // non-uniform spacing exercises the transformation to object space
+  XYZVdbVolume *volume = nullptr;
+  REQUIRE_NOTHROW(volume = new XYZVdbVolume(16,
+                                            vec3f(-1.f, 0.f, 1.f),
+                                            vec3f(0.5f, 1.f, 2.f),
+                                            VKL_FILTER_TRILINEAR));
+
+  VKLVolume vklVolume = volume->getVKLVolume();
+
+  // the trilinear interpolant of the XYZ field is the field itself, so its
+  // analytic gradient is exact
+  multidim_index_sequence<3> mis(volume->getDimensions() - 1);
+  for (const auto &offset : mis) {
+    const vec3f objectCoordinates = volume->transformLocalToObjectCoordinates(
+        vec3f(offset) + vec3f(0.25f, 0.5f, 0.75f));
+
+    INFO("offset = " << offset.x << " " << offset.y << " " << offset.z);
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    const vkl_vec3f vklGradient =
+        vklComputeGradient(vklVolume, (const vkl_vec3f *)&objectCoordinates);
+
+    const vec3f &oc = objectCoordinates;
+    REQUIRE(vklGradient.x == Approx(oc.y * oc.z).margin(1e-2f));
+    REQUIRE(vklGradient.y == Approx(oc.x * oc.z).margin(1e-2f));
+    REQUIRE(vklGradient.z == Approx(oc.x * oc.y).margin(1e-2f));
+  }
+
+  REQUIRE_NOTHROW(delete volume);
+}
+
+TEST_CASE("VDB volume sampling with accessors", "[volume_sampling]")
+{
+  init_driver();
+
+  for (VKLFilter filter :
+       {VKL_FILTER_NEAREST, VKL_FILTER_TRILINEAR, VKL_FILTER_TRICUBIC}) {
+    INFO("filter = " << filter);
+
+    WaveletVdbVolume *volume = nullptr;
+    REQUIRE_NOTHROW(volume = new WaveletVdbVolume(
+                        128, vec3f(0.f), vec3f(1.f), filter));
+
+    VKLVolume vklVolume = volume->getVKLVolume();
+
+    VKLAccessor accessor;
+    vklInitAccessor(&accessor, vklVolume);
+
+    // march along lines through the volume, starting and ending outside; the
+    // accessor must not change any samples, neither for coherent steps nor
+    // when jumping between lines
+    const vec3f directions[] = {vec3f(1.f, 0.f, 0.f),
+                                vec3f(0.f, 0.f, 1.f),
+                                vec3f(1.f, 0.7f, 0.3f),
+                                vec3f(-0.5f, 1.f, -1.f)};
+
+    for (const vec3f &direction : directions) {
+      const vec3f origin = vec3f(64.f) - 100.f * normalize(direction);
+
+      for (float t = 0.f; t < 200.f; t += 0.37f) {
+        const vec3f objectCoordinates = origin + t * normalize(direction);
+
+        INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                    << objectCoordinates.y << " "
+                                    << objectCoordinates.z);
+
+        const float sample = vklComputeSampleWithAccessor(
+            &accessor, (const vkl_vec3f *)&objectCoordinates);
+        const float referenceSample = vklComputeSample(
+            vklVolume, (const vkl_vec3f *)&objectCoordinates);
+
+        REQUIRE(sample == referenceSample);
+      }
+    }
+
+    REQUIRE_NOTHROW(delete volume);
+  }
+}
+
+TEST_CASE("VDB volume sampling with accessors after recommit",
+          "[volume_sampling]")
+{
+  init_driver();
+
+  WaveletVdbVolume *volume = nullptr;
+  REQUIRE_NOTHROW(volume = new WaveletVdbVolume(
+                      128, vec3f(0.f), vec3f(1.f), VKL_FILTER_TRILINEAR));
+
+  VKLVolume vklVolume = volume->getVKLVolume();
+
+  VKLAccessor accessor;
+  vklInitAccessor(&accessor, vklVolume);
+
+  const vec3f objectCoordinates(64.3f, 31.7f, 90.1f);
+
+  // the recommit frees the grid the accessor has cached nodes of; its
+  // replacement may be allocated at the same address
+  for (VKLFilter filter :
+       {VKL_FILTER_NEAREST, VKL_FILTER_TRICUBIC, VKL_FILTER_TRILINEAR}) {
+    INFO("filter = " << filter);
+
+    vklComputeSampleWithAccessor(&accessor,
+                                 (const vkl_vec3f *)&objectCoordinates);
+
+    vklSetInt(vklVolume, "filter", filter);
+    vklCommit(vklVolume);
+
+    const float sample = vklComputeSampleWithAccessor(
+        &accessor, (const vkl_vec3f *)&objectCoordinates);
+    const float referenceSample =
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates);
+
+    REQUIRE(sample == referenceSample);
+  }
+
+  REQUIRE_NOTHROW(delete volume);
+}
+
+// creates a vdb volume of numLeaves^3 leaf nodes in the given format. the
+// leaf voxels hold the quantized values q, with the given per-leaf scale and
+// offset. all values are chosen to be exactly representable in all formats.
+static VKLVolume createQuantizedVdbVolume(
+    VKLVdbLeafFormat format,
+    VKLFilter filter,
+    int numLeaves,
+    const std::vector<std::vector<uint8_t>> &q,
+    const std::vector<float> &scale,
+    const std::vector<float> &offset)
+{
+  const uint32_t leafLevel = vklVdbNumLevels() - 1;
+  const int leafRes        = vklVdbLevelRes(leafLevel);
+
+  std::vector<uint32_t> levels;
+  std::vector<vec3i> origins;
+  std::vector<uint32_t> formats;
+  std::vector<VKLData> data;
+
+  multidim_index_sequence<3> mis(vec3i(numLeaves));
+  for (const auto &leaf : mis) {
+    const size_t i                    = data.size();
+    const std::vector<uint8_t> &leafQ = q[i];
+
+    levels.push_back(leafLevel);
+    origins.push_back(leaf * leafRes);
+    formats.push_back(format);
+
+    switch (format) {
+    case VKL_VDB_FORMAT_CONSTANT: {
+      std::vector<float> values;
+      for (uint8_t v : leafQ)
+        values.push_back(offset[i] + scale[i] * v);
+      data.push_back(vklNewData(values.size(), VKL_FLOAT, values.data()));
+      break;
+    }
+    case VKL_VDB_FORMAT_CONSTANT_HALF: {
+      std::vector<uint16_t> values;
+      for (uint8_t v : leafQ)
+        values.push_back(floatToHalf(offset[i] + scale[i] * v));
+      data.push_back(vklNewData(values.size(), VKL_HALF, values.data()));
+      break;
+    }
+    case VKL_VDB_FORMAT_CONSTANT_UCHAR:
+      data.push_back(vklNewData(leafQ.size(), VKL_UCHAR, leafQ.data()));
+      break;
+    case VKL_VDB_FORMAT_CONSTANT_USHORT: {
+      const std::vector<uint16_t> values(leafQ.begin(), leafQ.end());
+      data.push_back(vklNewData(values.size(), VKL_USHORT, values.data()));
+      break;
+    }
+    default:
+      throw std::runtime_error("unexpected leaf format");
+    }
+  }
+
+  VKLVolume volume = vklNewVolume("vdb");
+  vklSetInt(volume, "type", VKL_FLOAT);
+  vklSetInt(volume, "filter", filter);
+
+  const size_t numNodes = levels.size();
+
+  VKLData levelData  = vklNewData(numNodes, VKL_UINT, levels.data());
+  VKLData originData = vklNewData(numNodes, VKL_VEC3I, origins.data());
+  VKLData formatData = vklNewData(numNodes, VKL_UINT, formats.data());
+  VKLData dataData   = vklNewData(numNodes, VKL_DATA, data.data());
+  VKLData scaleData  = vklNewData(numNodes, VKL_FLOAT, scale.data());
+  VKLData offsetData = vklNewData(numNodes, VKL_FLOAT, offset.data());
+
+  vklSetData(volume, "level", levelData);
+  vklSetData(volume, "origin", originData);
+  vklSetData(volume, "format", formatData);
+  vklSetData(volume, "data", dataData);
+  vklSetData(volume, "quantizationScale", scaleData);
+  vklSetData(volume, "quantizationOffset", offsetData);
+
+  for (VKLData d : {levelData, originData, formatData, dataData, scaleData,
+                    offsetData}) {
+    vklRelease(d);
+  }
+
+  for (VKLData d : data) {
+    vklRelease(d);
+  }
+
+  vklCommit(volume);
+
+  return volume;
+}
+
+TEST_CASE("VDB volume half precision and quantized leaves",
+          "[volume_sampling]")
+{
+  init_driver();
+
+  const int numLeaves        = 3;
+  const int leafRes          = vklVdbLevelRes(vklVdbNumLevels() - 1);
+  const size_t numLeafVoxels = vklVdbLevelNumVoxels(vklVdbNumLevels() - 1);
+
+  // per-leaf scales and offsets, including negative scales
+  std::vector<std::vector<uint8_t>> q;
+  std::vector<float> scale;
+  std::vector<float> offset;
+
+  for (int i = 0; i < numLeaves * numLeaves * numLeaves; i++) {
+    std::vector<uint8_t> leafQ(numLeafVoxels);
+    for (size_t v = 0; v < numLeafVoxels; v++) {
+      leafQ[v] = (7 * v + 13 * i) % 256;
+    }
+    q.push_back(leafQ);
+
+    scale.push_back((i % 2 ? -0.25f : 0.5f));
+    offset.push_back(0.5f * (i % 5));
+  }
+
+  for (VKLFilter filter :
+       {VKL_FILTER_NEAREST, VKL_FILTER_TRILINEAR, VKL_FILTER_TRICUBIC}) {
+    INFO("filter = " << filter);
+
+    VKLVolume reference = createQuantizedVdbVolume(
+        VKL_VDB_FORMAT_CONSTANT, filter, numLeaves, q, scale, offset);
+
+    for (VKLVdbLeafFormat format : {VKL_VDB_FORMAT_CONSTANT_HALF,
+                                    VKL_VDB_FORMAT_CONSTANT_UCHAR,
+                                    VKL_VDB_FORMAT_CONSTANT_USHORT}) {
+      INFO("format = " << format);
+
+      VKLVolume volume = createQuantizedVdbVolume(
+          format, filter, numLeaves, q, scale, offset);
+
+      REQUIRE(vklGetValueRange(volume).lower ==
+              vklGetValueRange(reference).lower);
+      REQUIRE(vklGetValueRange(volume).upper ==
+              vklGetValueRange(reference).upper);
+
+      // voxel values are identical, so samples must be identical as well;
+      // this covers stencils inside leaves and across leaf boundaries
+      multidim_index_sequence<3> mis(vec3i(numLeaves * leafRes));
+      for (const auto &voxel : mis) {
+        const vec3f objectCoordinates =
+            vec3f(voxel) + vec3f(0.25f, 0.5f, 0.75f);
+
+        INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                    << objectCoordinates.y << " "
+                                    << objectCoordinates.z);
+
+        test_scalar_and_vector_sampling(
+            volume,
+            objectCoordinates,
+            vklComputeSample(reference,
+                             (const vkl_vec3f *)&objectCoordinates),
+            0.f);
+      }
+
+      vklRelease(volume);
+    }
+
+    vklRelease(reference);
+  }
+}
+
 TEST_CASE("VDB volume interval iterator", "[volume_sampling]")
 {
   init_driver();
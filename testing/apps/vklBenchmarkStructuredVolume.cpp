@@ -1,12 +1,21 @@
 // Copyright 2019-2020 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <random>
+#include <sstream>
 #include "../common/simd.h"
 #include "benchmark/benchmark.h"
 #include "openvkl_testing.h"
 #include "ospcommon/utility/random.h"
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 using namespace openvkl;
 using namespace openvkl::testing;
 using namespace ospcommon::utility;
@@ -102,6 +111,532 @@ BENCHMARK_TEMPLATE(vectorRandomSample, 4);
 BENCHMARK_TEMPLATE(vectorRandomSample, 8);
 BENCHMARK_TEMPLATE(vectorRandomSample, 16);
 
+// random sampling with voxel layout (range 0) and volume dimension (range 1)
+// as arguments; incoherent access to large volumes benefits most from the
+// bricked and Morton layouts
+template <int W>
+void vectorRandomSampleLayout(benchmark::State &state)
+{
+  const VKLStructuredLayout layout = (VKLStructuredLayout)state.range(0);
+  const int dimension              = state.range(1);
+
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+      vec3i(dimension), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetInt(vklVolume, "layout", layout);
+  vklCommit(vklVolume);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = 1;
+  }
+
+  vvec3fn<W> objectCoordinates;
+  float samples[W];
+
+  for (auto _ : state) {
+    for (int i = 0; i < W; i++) {
+      objectCoordinates.x[i] = distX();
+      objectCoordinates.y[i] = distY();
+      objectCoordinates.z[i] = distZ();
+    }
+
+    if (W == 4) {
+      vklComputeSample4(
+          valid, vklVolume, (const vkl_vvec3f4 *)&objectCoordinates, samples);
+    } else if (W == 8) {
+      vklComputeSample8(
+          valid, vklVolume, (const vkl_vvec3f8 *)&objectCoordinates, samples);
+    } else if (W == 16) {
+      vklComputeSample16(
+          valid, vklVolume, (const vkl_vvec3f16 *)&objectCoordinates, samples);
+    } else {
+      throw std::runtime_error(
+          "vectorRandomSampleLayout benchmark called with unimplemented "
+          "calling width");
+    }
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * W);
+}
+
+#define VKL_BENCHMARK_LAYOUTS(W)                                \
+  BENCHMARK_TEMPLATE(vectorRandomSampleLayout, W)               \
+      ->Args({VKL_STRUCTURED_LAYOUT_LINEAR, 128})               \
+      ->Args({VKL_STRUCTURED_LAYOUT_BRICKED, 128})              \
+      ->Args({VKL_STRUCTURED_LAYOUT_MORTON, 128})               \
+      ->Args({VKL_STRUCTURED_LAYOUT_LINEAR, 512})               \
+      ->Args({VKL_STRUCTURED_LAYOUT_BRICKED, 512})              \
+      ->Args({VKL_STRUCTURED_LAYOUT_MORTON, 512})
+
+VKL_BENCHMARK_LAYOUTS(4);
+VKL_BENCHMARK_LAYOUTS(8);
+VKL_BENCHMARK_LAYOUTS(16);
+
+#undef VKL_BENCHMARK_LAYOUTS
+
+// random sampling of the uncompressed (range 0 = 0) or compressed (range 0 = 1)
+// volume type, with volume dimension as range 1. the compressed volume uses a
+// quarter of the memory of the float voxel data.
+template <int W>
+void vectorRandomSampleCompressed(benchmark::State &state)
+{
+  const bool compressed = state.range(0);
+  const int dimension   = state.range(1);
+
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+      vec3i(dimension), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  VKLVolume compressedVolume = nullptr;
+
+  if (compressed) {
+    std::vector<unsigned char> voxels = v->generateVoxels();
+
+    compressedVolume = vklNewVolume("structuredRegularCompressed");
+
+    vklSetVec3i(
+        compressedVolume, "dimensions", dimension, dimension, dimension);
+
+    VKLData data = vklNewData(
+        size_t(dimension) * dimension * dimension, VKL_FLOAT, voxels.data());
+    vklSetData(compressedVolume, "data", data);
+    vklRelease(data);
+
+    vklCommit(compressedVolume);
+
+    vklVolume = compressedVolume;
+  }
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = 1;
+  }
+
+  vvec3fn<W> objectCoordinates;
+  float samples[W];
+
+  for (auto _ : state) {
+    for (int i = 0; i < W; i++) {
+      objectCoordinates.x[i] = distX();
+      objectCoordinates.y[i] = distY();
+      objectCoordinates.z[i] = distZ();
+    }
+
+    if (W == 4) {
+      vklComputeSample4(
+          valid, vklVolume, (const vkl_vvec3f4 *)&objectCoordinates, samples);
+    } else if (W == 8) {
+      vklComputeSample8(
+          valid, vklVolume, (const vkl_vvec3f8 *)&objectCoordinates, samples);
+    } else if (W == 16) {
+      vklComputeSample16(
+          valid, vklVolume, (const vkl_vvec3f16 *)&objectCoordinates, samples);
+    } else {
+      throw std::runtime_error(
+          "vectorRandomSampleCompressed benchmark called with unimplemented "
+          "calling width");
+    }
+  }
+
+  if (compressedVolume) {
+    vklRelease(compressedVolume);
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * W);
+}
+
+#define VKL_BENCHMARK_COMPRESSED(W)                   \
+  BENCHMARK_TEMPLATE(vectorRandomSampleCompressed, W) \
+      ->Args({0, 128})                                \
+      ->Args({1, 128})                                \
+      ->Args({0, 512})                                \
+      ->Args({1, 512})
+
+VKL_BENCHMARK_COMPRESSED(4);
+VKL_BENCHMARK_COMPRESSED(8);
+VKL_BENCHMARK_COMPRESSED(16);
+
+#undef VKL_BENCHMARK_COMPRESSED
+
+// random sampling with the filter as argument (range 0)
+static void scalarRandomSampleFilter(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+      vec3i(128), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetInt(vklVolume, "filter", state.range(0));
+  vklCommit(vklVolume);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  for (auto _ : state) {
+    vkl_vec3f objectCoordinates{distX(), distY(), distZ()};
+
+    benchmark::DoNotOptimize(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates));
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(scalarRandomSampleFilter)
+    ->Arg(VKL_FILTER_TRILINEAR)
+    ->Arg(VKL_FILTER_TRICUBIC);
+
+// volume commit, including the accelerator build, with the volume dimension as
+// argument (range 0)
+static void volumeCommit(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+      vec3i(state.range(0)), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  for (auto _ : state) {
+    vklCommit(vklVolume);
+  }
+
+  // voxels per second in report output
+  state.SetItemsProcessed(state.iterations() * int64_t(state.range(0)) *
+                          state.range(0) * state.range(0));
+}
+
+BENCHMARK(volumeCommit)
+    ->Arg(128)
+    ->Arg(256)
+    ->Arg(512)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void streamRandomSample(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+      vec3i(128), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  const unsigned int N = state.range(0);
+
+  // coordinates are generated once; the benchmark measures sampling only
+  std::vector<vkl_vec3f> objectCoordinates(N);
+  std::vector<float> samples(N);
+
+  for (auto &oc : objectCoordinates) {
+    oc = vkl_vec3f{distX(), distY(), distZ()};
+  }
+
+  for (auto _ : state) {
+    vklComputeSampleN(vklVolume, N, objectCoordinates.data(), samples.data());
+
+    benchmark::DoNotOptimize(samples.data());
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(streamRandomSample)->Range(16, 1 << 20)->UseRealTime();
+
+static void streamRandomSampleAndGradient(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+      vec3i(128), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  const unsigned int N = state.range(0);
+
+  std::vector<vkl_vec3f> objectCoordinates(N);
+  std::vector<float> samples(N);
+  std::vector<vkl_vec3f> gradients(N);
+
+  for (auto &oc : objectCoordinates) {
+    oc = vkl_vec3f{distX(), distY(), distZ()};
+  }
+
+  for (auto _ : state) {
+    vklComputeSampleAndGradientN(vklVolume,
+                                 N,
+                                 objectCoordinates.data(),
+                                 samples.data(),
+                                 gradients.data());
+
+    benchmark::DoNotOptimize(samples.data());
+    benchmark::DoNotOptimize(gradients.data());
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(streamRandomSampleAndGradient)->Range(16, 1 << 20)->UseRealTime();
+
+// samples three attributes defined on the same grid, either from three single
+// attribute volumes (argument 0), or from one volume with three attributes
+// (argument 1)
+static void streamRandomSampleMultiAttribute(benchmark::State &state)
+{
+  const bool multiAttribute = state.range(0);
+
+  const vec3i dimensions(128);
+  const unsigned int numAttributes = 3;
+
+  std::vector<std::vector<float>> voxels(numAttributes);
+
+  for (unsigned int a = 0; a < numAttributes; a++) {
+    voxels[a].reserve(dimensions.long_product());
+
+    for (int z = 0; z < dimensions.z; z++) {
+      for (int y = 0; y < dimensions.y; y++) {
+        for (int x = 0; x < dimensions.x; x++) {
+          voxels[a].push_back(std::sin(0.1f * (a + 1) * x) +
+                              std::cos(0.2f * y) + 0.01f * z);
+        }
+      }
+    }
+  }
+
+  auto newVolume = [&](VKLData data) {
+    VKLVolume volume = vklNewVolume("structuredRegular");
+    vklSetVec3i(
+        volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+    vklSetData(volume, "data", data);
+    vklCommit(volume);
+    vklRelease(data);
+    return volume;
+  };
+
+  std::vector<VKLData> attributesData;
+
+  for (const auto &attributeVoxels : voxels) {
+    attributesData.push_back(vklNewData(attributeVoxels.size(),
+                                        VKL_FLOAT,
+                                        attributeVoxels.data(),
+                                        VKL_DATA_SHARED_BUFFER));
+  }
+
+  std::vector<VKLVolume> volumes;
+
+  if (multiAttribute) {
+    volumes.push_back(newVolume(vklNewData(attributesData.size(),
+                                           VKL_DATA,
+                                           attributesData.data(),
+                                           VKL_DATA_DEFAULT)));
+
+    for (VKLData data : attributesData) {
+      vklRelease(data);
+    }
+  } else {
+    for (VKLData data : attributesData) {
+      volumes.push_back(newVolume(data));
+    }
+  }
+
+  vkl_box3f bbox = vklGetBoundingBox(volumes[0]);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  const unsigned int N = 1 << 16;
+
+  std::vector<vkl_vec3f> objectCoordinates(N);
+  std::vector<float> samples(numAttributes * N);
+
+  for (auto &oc : objectCoordinates) {
+    oc = vkl_vec3f{distX(), distY(), distZ()};
+  }
+
+  const std::vector<unsigned int> attributeIndices{0, 1, 2};
+
+  for (auto _ : state) {
+    if (multiAttribute) {
+      vklComputeSampleMN(volumes[0],
+                         N,
+                         objectCoordinates.data(),
+                         samples.data(),
+                         numAttributes,
+                         attributeIndices.data());
+    } else {
+      for (unsigned int a = 0; a < numAttributes; a++) {
+        vklComputeSampleN(volumes[a],
+                          N,
+                          objectCoordinates.data(),
+                          samples.data() + a * N);
+      }
+    }
+
+    benchmark::DoNotOptimize(samples.data());
+  }
+
+  for (VKLVolume volume : volumes) {
+    vklRelease(volume);
+  }
+
+  // enables rates in report output; items are coordinates, each sampled for
+  // all attributes
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(streamRandomSampleMultiAttribute)->Arg(0)->Arg(1)->UseRealTime();
+
+// samples a volume with two timesteps at random times, either by sampling two
+// single timestep volumes and interpolating in the application (argument 0),
+// or from one time-varying volume (argument 1)
+static void streamRandomSampleAtTime(benchmark::State &state)
+{
+  const bool timeVarying = state.range(0);
+
+  const vec3i dimensions(128);
+  const unsigned int numTimesteps = 2;
+
+  std::vector<std::vector<float>> voxels(numTimesteps);
+
+  for (unsigned int t = 0; t < numTimesteps; t++) {
+    voxels[t].reserve(dimensions.long_product());
+
+    for (int z = 0; z < dimensions.z; z++) {
+      for (int y = 0; y < dimensions.y; y++) {
+        for (int x = 0; x < dimensions.x; x++) {
+          voxels[t].push_back(std::sin(0.1f * x + t) + std::cos(0.2f * y) +
+                              0.01f * z);
+        }
+      }
+    }
+  }
+
+  auto newVolume = [&](const char *name, VKLData data) {
+    VKLVolume volume = vklNewVolume("structuredRegular");
+    vklSetVec3i(
+        volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+    vklSetData(volume, name, data);
+    vklCommit(volume);
+    vklRelease(data);
+    return volume;
+  };
+
+  std::vector<VKLData> timestepsData;
+
+  for (const auto &timestepVoxels : voxels) {
+    timestepsData.push_back(vklNewData(timestepVoxels.size(),
+                                       VKL_FLOAT,
+                                       timestepVoxels.data(),
+                                       VKL_DATA_SHARED_BUFFER));
+  }
+
+  std::vector<VKLVolume> volumes;
+
+  if (timeVarying) {
+    volumes.push_back(newVolume("timestepData",
+                                vklNewData(timestepsData.size(),
+                                           VKL_DATA,
+                                           timestepsData.data(),
+                                           VKL_DATA_DEFAULT)));
+
+    for (VKLData data : timestepsData) {
+      vklRelease(data);
+    }
+  } else {
+    for (VKLData data : timestepsData) {
+      volumes.push_back(newVolume("data", data));
+    }
+  }
+
+  vkl_box3f bbox = vklGetBoundingBox(volumes[0]);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+  pcg32_biased_float_distribution distTime(rd(), 0, 0.f, 1.f);
+
+  const unsigned int N = 1 << 16;
+
+  std::vector<vkl_vec3f> objectCoordinates(N);
+  std::vector<float> times(N);
+  std::vector<float> samples(numTimesteps * N);
+
+  for (unsigned int i = 0; i < N; i++) {
+    objectCoordinates[i] = vkl_vec3f{distX(), distY(), distZ()};
+    times[i]             = distTime();
+  }
+
+  for (auto _ : state) {
+    if (timeVarying) {
+      vklComputeSampleAtTimeN(volumes[0],
+                              N,
+                              objectCoordinates.data(),
+                              times.data(),
+                              samples.data());
+    } else {
+      vklComputeSampleN(
+          volumes[0], N, objectCoordinates.data(), samples.data());
+      vklComputeSampleN(
+          volumes[1], N, objectCoordinates.data(), samples.data() + N);
+
+      for (unsigned int i = 0; i < N; i++) {
+        samples[i] = (1.f - times[i]) * samples[i] + times[i] * samples[N + i];
+      }
+    }
+
+    benchmark::DoNotOptimize(samples.data());
+  }
+
+  for (VKLVolume volume : volumes) {
+    vklRelease(volume);
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(streamRandomSampleAtTime)->Arg(0)->Arg(1)->UseRealTime();
+
 static void scalarFixedSample(benchmark::State &state)
 {
   auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
@@ -530,6 +1065,402 @@ BENCHMARK(scalarIntervalIteratorIterateSecond)->Threads(12)->UseRealTime();
 BENCHMARK(scalarIntervalIteratorIterateSecond)->Threads(36)->UseRealTime();
 BENCHMARK(scalarIntervalIteratorIterateSecond)->Threads(72)->UseRealTime();
 
+// full interval iteration along random rays with the macrocell width as
+// argument (range 0). a value selector over a narrow value range exercises
+// space skipping, which benefits from smaller macrocells, while each macrocell
+// visited adds a fixed traversal cost.
+static void scalarIntervalIteratorMacrocellWidth(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+      vec3i(256), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetInt(vklVolume, "macrocellWidth", state.range(0));
+  vklCommit(vklVolume);
+
+  VKLValueSelector valueSelector = vklNewValueSelector(vklVolume);
+
+  vkl_range1f valueRange{0.9f, 1.f};
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+
+  // origins are generated once; the benchmark measures iteration only
+  std::vector<vkl_vec3f> origins(1024);
+
+  for (auto &origin : origins) {
+    origin = vkl_vec3f{distX(eng), distY(eng), -1.f};
+  }
+
+  vkl_vec3f direction{0.f, 0.f, 1.f};
+  vkl_range1f tRange{0.f, 1000.f};
+
+  size_t rayIndex      = 0;
+  size_t intervalCount = 0;
+
+  for (auto _ : state) {
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(&iterator,
+                            vklVolume,
+                            &origins[rayIndex++ % origins.size()],
+                            &direction,
+                            &tRange,
+                            valueSelector);
+
+    VKLInterval interval;
+
+    while (vklIterateInterval(&iterator, &interval)) {
+      intervalCount++;
+    }
+
+    benchmark::DoNotOptimize(interval);
+  }
+
+  vklRelease(valueSelector);
+
+  state.counters["intervalsPerRay"] =
+      benchmark::Counter(double(intervalCount) / state.iterations());
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(scalarIntervalIteratorMacrocellWidth)
+    ->RangeMultiplier(2)
+    ->Range(2, 128);
+
+// full interval iteration along random rays through a volume which is mostly
+// outside of the value selector range, with the macrocell width as argument
+// (range 0). most of the volume is skipped using the coarse levels of the
+// accelerator's value range hierarchy, so that the number of macrocells
+// visited does not grow with smaller macrocells.
+static void scalarIntervalIteratorSparse(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<XYZStructuredRegularVolume<float>>(
+      vec3i(256), vec3f(0.f), vec3f(1.f / 255.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetInt(vklVolume, "macrocellWidth", state.range(0));
+  vklCommit(vklVolume);
+
+  VKLValueSelector valueSelector = vklNewValueSelector(vklVolume);
+
+  vkl_range1f valueRange{0.9f, 1.f};
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+
+  // origins are generated once; the benchmark measures iteration only
+  std::vector<vkl_vec3f> origins(1024);
+
+  for (auto &origin : origins) {
+    origin = vkl_vec3f{distX(eng), distY(eng), -1.f};
+  }
+
+  vkl_vec3f direction{0.f, 0.f, 1.f};
+  vkl_range1f tRange{0.f, 1000.f};
+
+  size_t rayIndex      = 0;
+  size_t intervalCount = 0;
+
+  for (auto _ : state) {
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(&iterator,
+                            vklVolume,
+                            &origins[rayIndex++ % origins.size()],
+                            &direction,
+                            &tRange,
+                            valueSelector);
+
+    VKLInterval interval;
+
+    while (vklIterateInterval(&iterator, &interval)) {
+      intervalCount++;
+    }
+
+    benchmark::DoNotOptimize(interval);
+  }
+
+  vklRelease(valueSelector);
+
+  state.counters["intervalsPerRay"] =
+      benchmark::Counter(double(intervalCount) / state.iterations());
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(scalarIntervalIteratorSparse)->RangeMultiplier(2)->Range(2, 32);
+
+// updating a 256^3 shared buffer volume after modifying a cubic region of
+// voxels with the given width (range 0), via vklVolumeInvalidateRegion(). the
+// cost of a full commit is included as a reference for the largest width.
+static void invalidateRegion(benchmark::State &state)
+{
+  const vec3i dimensions(256);
+
+  std::vector<float> voxels(dimensions.long_product(), 0.f);
+
+  VKLVolume vklVolume = vklNewVolume("structuredRegular");
+
+  vklSetVec3i(
+      vklVolume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  VKLData data = vklNewData(
+      voxels.size(), VKL_FLOAT, voxels.data(), VKL_DATA_SHARED_BUFFER);
+  vklSetData(vklVolume, "data", data);
+  vklRelease(data);
+
+  vklCommit(vklVolume);
+
+  const int width = state.range(0);
+  const int upper = 64 + width - 1;
+
+  const vkl_box3i region{{64, 64, 64}, {upper, upper, upper}};
+
+  for (auto _ : state) {
+    if (width == dimensions.x) {
+      vklCommit(vklVolume);
+    } else {
+      vklVolumeInvalidateRegion(vklVolume, &region);
+    }
+  }
+
+  vklRelease(vklVolume);
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(invalidateRegion)->RangeMultiplier(4)->Range(4, 256);
+
+// random sampling of a 384^3 out-of-core volume backed by a synthetic raw
+// file, with the brick cache holding the given number of 64^3 bricks (range
+// 0) out of 216. hits and misses include those of the commit.
+static void scalarRandomSampleOutOfCore(benchmark::State &state)
+{
+  const vec3i dimensions(384);
+
+  const std::string filename = "vklBenchmark_out_of_core.raw";
+
+  {
+    std::ofstream output(filename, std::ios::binary);
+
+    std::vector<float> slice(size_t(dimensions.x) * dimensions.y);
+
+    for (int z = 0; z < dimensions.z; z++) {
+      for (int y = 0; y < dimensions.y; y++) {
+        for (int x = 0; x < dimensions.x; x++) {
+          slice[x + size_t(dimensions.x) * y] =
+              std::sin(0.05f * x) * std::cos(0.07f * y) + 0.002f * z;
+        }
+      }
+
+      output.write((const char *)slice.data(), slice.size() * sizeof(float));
+    }
+  }
+
+  VKLVolume vklVolume = vklNewVolume("structuredRegularOutOfCore");
+
+  vklSetVec3i(
+      vklVolume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetString(vklVolume, "filename", filename.c_str());
+  vklSetInt(vklVolume, "maxCachedBricks", state.range(0));
+
+  vklCommit(vklVolume);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  for (auto _ : state) {
+    vkl_vec3f objectCoordinates{distX(), distY(), distZ()};
+
+    benchmark::DoNotOptimize(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates));
+  }
+
+  VKLObserver observer = vklNewObserver(vklVolume, "BrickCacheStatistics");
+
+  const uint64_t *statistics =
+      static_cast<const uint64_t *>(vklMapObserver(observer));
+
+  state.counters["hits"]   = benchmark::Counter(statistics[0]);
+  state.counters["misses"] = benchmark::Counter(statistics[1]);
+
+  vklUnmapObserver(observer);
+  vklRelease(observer);
+
+  vklRelease(vklVolume);
+
+  std::remove(filename.c_str());
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(scalarRandomSampleOutOfCore)->RangeMultiplier(4)->Range(8, 512);
+
+// restricts the calling thread to the logical CPUs of a NUMA node while in
+// scope
+struct NumaNodeAffinity
+{
+  NumaNodeAffinity(int node)
+  {
+#ifdef __linux__
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) +
+                       "/cpulist");
+    std::string cpuList;
+
+    if (!std::getline(file, cpuList)) {
+      return;
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    std::stringstream stream(cpuList);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+      int first, last;
+      const int numMatched = std::sscanf(range.c_str(), "%d-%d", &first, &last);
+
+      if (numMatched < 1) {
+        continue;
+      } else if (numMatched == 1) {
+        last = first;
+      }
+
+      for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+        CPU_SET(cpu, &cpuSet);
+      }
+    }
+
+    pthread_getaffinity_np(
+        pthread_self(), sizeof(previousCpuSet), &previousCpuSet);
+
+    valid =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+  }
+
+  ~NumaNodeAffinity()
+  {
+#ifdef __linux__
+    if (valid) {
+      pthread_setaffinity_np(
+          pthread_self(), sizeof(previousCpuSet), &previousCpuSet);
+    }
+#endif
+  }
+
+  bool valid{false};
+
+ private:
+#ifdef __linux__
+  cpu_set_t previousCpuSet;
+#endif
+};
+
+// random sampling of a 384^3 volume from a thread running on the NUMA node
+// given as argument (range 0), with the voxel data placed by first touch on the
+// node of the main thread (range 1 = 0), interleaved over all nodes (1), or
+// replicated to each node (2). comparing the rates of all nodes shows the cost
+// of remote accesses for each placement.
+static void scalarRandomSampleNuma(benchmark::State &state)
+{
+  const int node = state.range(0);
+  const int mode = state.range(1);
+
+  const vec3i dimensions(384);
+
+  std::vector<float> voxels(dimensions.long_product());
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        voxels[x + dimensions.x * (y + size_t(dimensions.y) * z)] =
+            std::sin(0.05f * x) * std::cos(0.07f * y) + 0.002f * z;
+      }
+    }
+  }
+
+  VKLVolume vklVolume = vklNewVolume("structuredRegular");
+
+  vklSetVec3i(
+      vklVolume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetInt(vklVolume, "numaReplicas", mode == 2);
+
+  VKLData data = vklNewData(
+      voxels.size(),
+      VKL_FLOAT,
+      voxels.data(),
+      mode == 1 ? VKL_DATA_NUMA_INTERLEAVED : VKL_DATA_DEFAULT);
+  vklSetData(vklVolume, "data", data);
+  vklRelease(data);
+
+  vklCommit(vklVolume);
+
+  NumaNodeAffinity affinity(node);
+
+  if (!affinity.valid) {
+    vklRelease(vklVolume);
+    state.SkipWithError("NUMA node not available");
+    return;
+  }
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  for (auto _ : state) {
+    vkl_vec3f objectCoordinates{distX(), distY(), distZ()};
+
+    benchmark::DoNotOptimize(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates));
+  }
+
+  vklRelease(vklVolume);
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+// up to four nodes; benchmarks for nodes which are not available are skipped
+static void numaArguments(benchmark::internal::Benchmark *benchmark)
+{
+  for (int node = 0; node < 4; node++) {
+    for (int mode = 0; mode < 3; mode++) {
+      benchmark->Args({node, mode});
+    }
+  }
+}
+
+BENCHMARK(scalarRandomSampleNuma)->Apply(numaArguments);
+
 // based on BENCHMARK_MAIN() macro from benchmark.h
 int main(int argc, char **argv)
 {
@@ -48,6 +48,7 @@ static void scalarRandomSample(benchmark::State &state)
 
 BENCHMARK_TEMPLATE(scalarRandomSample, VKL_FILTER_NEAREST);
 BENCHMARK_TEMPLATE(scalarRandomSample, VKL_FILTER_TRILINEAR);
+BENCHMARK_TEMPLATE(scalarRandomSample, VKL_FILTER_TRICUBIC);
 
 template <int W, VKLFilter filter>
 void vectorRandomSample(benchmark::State &state)
@@ -115,6 +116,10 @@ BENCHMARK_TEMPLATE(vectorRandomSample, 4, VKL_FILTER_TRILINEAR);
 BENCHMARK_TEMPLATE(vectorRandomSample, 8, VKL_FILTER_TRILINEAR);
 BENCHMARK_TEMPLATE(vectorRandomSample, 16, VKL_FILTER_TRILINEAR);
 
+BENCHMARK_TEMPLATE(vectorRandomSample, 4, VKL_FILTER_TRICUBIC);
+BENCHMARK_TEMPLATE(vectorRandomSample, 8, VKL_FILTER_TRICUBIC);
+BENCHMARK_TEMPLATE(vectorRandomSample, 16, VKL_FILTER_TRICUBIC);
+
 template <VKLFilter filter>
 static void scalarFixedSample(benchmark::State &state)
 {
@@ -138,6 +143,7 @@ static void scalarFixedSample(benchmark::State &state)
 
 BENCHMARK_TEMPLATE(scalarFixedSample, VKL_FILTER_NEAREST);
 BENCHMARK_TEMPLATE(scalarFixedSample, VKL_FILTER_TRILINEAR);
+BENCHMARK_TEMPLATE(scalarFixedSample, VKL_FILTER_TRICUBIC);
 
 template <int W, VKLFilter filter>
 void vectorFixedSample(benchmark::State &state)
@@ -202,6 +208,116 @@ BENCHMARK_TEMPLATE(vectorFixedSample, 4, VKL_FILTER_TRILINEAR);
 BENCHMARK_TEMPLATE(vectorFixedSample, 8, VKL_FILTER_TRILINEAR);
 BENCHMARK_TEMPLATE(vectorFixedSample, 16, VKL_FILTER_TRILINEAR);
 
+BENCHMARK_TEMPLATE(vectorFixedSample, 4, VKL_FILTER_TRICUBIC);
+BENCHMARK_TEMPLATE(vectorFixedSample, 8, VKL_FILTER_TRICUBIC);
+BENCHMARK_TEMPLATE(vectorFixedSample, 16, VKL_FILTER_TRICUBIC);
+
+template <VKLFilter filter>
+static void scalarRandomGradient(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletVdbVolume>(
+      128, vec3f(0.f), vec3f(1.f), filter);
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  for (auto _ : state) {
+    vkl_vec3f objectCoordinates{distX(), distY(), distZ()};
+
+    benchmark::DoNotOptimize(
+        vklComputeGradient(vklVolume, (const vkl_vec3f *)&objectCoordinates));
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(scalarRandomGradient, VKL_FILTER_NEAREST);
+BENCHMARK_TEMPLATE(scalarRandomGradient, VKL_FILTER_TRILINEAR);
+BENCHMARK_TEMPLATE(scalarRandomGradient, VKL_FILTER_TRICUBIC);
+
+template <int W, VKLFilter filter>
+void vectorRandomGradient(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletVdbVolume>(
+      128, vec3f(0.f), vec3f(1.f), filter);
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  pcg32_biased_float_distribution distX(rd(), 0, bbox.lower.x, bbox.upper.x);
+  pcg32_biased_float_distribution distY(rd(), 0, bbox.lower.y, bbox.upper.y);
+  pcg32_biased_float_distribution distZ(rd(), 0, bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = 1;
+  }
+
+  struct vvec3f
+  {
+    float x[W];
+    float y[W];
+    float z[W];
+  };
+
+  vvec3f objectCoordinates;
+  vvec3f gradients;
+
+  for (auto _ : state) {
+    for (int i = 0; i < W; i++) {
+      objectCoordinates.x[i] = distX();
+      objectCoordinates.y[i] = distY();
+      objectCoordinates.z[i] = distZ();
+    }
+
+    if (W == 4) {
+      vklComputeGradient4(valid,
+                          vklVolume,
+                          (const vkl_vvec3f4 *)&objectCoordinates,
+                          (vkl_vvec3f4 *)&gradients);
+    } else if (W == 8) {
+      vklComputeGradient8(valid,
+                          vklVolume,
+                          (const vkl_vvec3f8 *)&objectCoordinates,
+                          (vkl_vvec3f8 *)&gradients);
+    } else if (W == 16) {
+      vklComputeGradient16(valid,
+                           vklVolume,
+                           (const vkl_vvec3f16 *)&objectCoordinates,
+                           (vkl_vvec3f16 *)&gradients);
+    } else {
+      throw std::runtime_error(
+          "vectorRandomGradient benchmark called with unimplemented calling "
+          "width");
+    }
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * W);
+}
+
+BENCHMARK_TEMPLATE(vectorRandomGradient, 4, VKL_FILTER_NEAREST);
+BENCHMARK_TEMPLATE(vectorRandomGradient, 8, VKL_FILTER_NEAREST);
+BENCHMARK_TEMPLATE(vectorRandomGradient, 16, VKL_FILTER_NEAREST);
+
+BENCHMARK_TEMPLATE(vectorRandomGradient, 4, VKL_FILTER_TRILINEAR);
+BENCHMARK_TEMPLATE(vectorRandomGradient, 8, VKL_FILTER_TRILINEAR);
+BENCHMARK_TEMPLATE(vectorRandomGradient, 16, VKL_FILTER_TRILINEAR);
+
+BENCHMARK_TEMPLATE(vectorRandomGradient, 4, VKL_FILTER_TRICUBIC);
+BENCHMARK_TEMPLATE(vectorRandomGradient, 8, VKL_FILTER_TRICUBIC);
+BENCHMARK_TEMPLATE(vectorRandomGradient, 16, VKL_FILTER_TRICUBIC);
+
 template <VKLFilter filter>
 static void scalarIntervalIteratorConstruction(benchmark::State &state)
 {
@@ -386,6 +502,33 @@ BENCHMARK_TEMPLATE(scalarIntervalIteratorIterateFirst, VKL_FILTER_TRILINEAR)
     ->Threads(72)
     ->UseRealTime();
 
+// volume commit, including the tree build, with the volume dimension as
+// argument (range 0)
+static void volumeCommit(benchmark::State &state)
+{
+  auto v = ospcommon::make_unique<WaveletVdbVolume>(
+      vec3i(state.range(0)), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  for (auto _ : state) {
+    vklCommit(vklVolume);
+  }
+
+  // leaves per second in report output
+  const int64_t leafRes      = vklVdbLevelRes(vklVdbNumLevels() - 1);
+  const int64_t numLeavesDim = (state.range(0) + leafRes - 1) / leafRes;
+  state.SetItemsProcessed(state.iterations() * numLeavesDim * numLeavesDim *
+                          numLeavesDim);
+}
+
+BENCHMARK(volumeCommit)
+    ->Arg(128)
+    ->Arg(256)
+    ->Arg(512)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 // based on BENCHMARK_MAIN() macro from benchmark.h
 int main(int argc, char **argv)
 {
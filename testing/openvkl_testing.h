@@ -11,3 +11,5 @@
 #include "volume/ProceduralUnstructuredVolume.h"
 #include "volume/ProceduralVdbVolume.h"
 #include "volume/RawFileStructuredVolume.h"
+#include "volume/half_float.h"
+#include "volume/structured_regular_helpers.h"
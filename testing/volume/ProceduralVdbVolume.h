@@ -159,6 +159,7 @@ namespace openvkl {
     };
 
     using WaveletVdbVolume = ProceduralVdbVolume<getWaveletValue<float>>;
+    using XYZVdbVolume     = ProceduralVdbVolume<getXYZValue<float>>;
 
   }  // namespace testing
 }  // namespace openvkl
@@ -24,6 +24,11 @@ namespace openvkl {
 
       std::vector<unsigned char> generateVoxels() override;
 
+     protected:
+      // maps the file rather than reading it, so that large files can be
+      // opened without reading them up front
+      void generateVKLVolume() override;
+
      private:
       std::string filename;
     };
@@ -66,5 +71,34 @@ namespace openvkl {
       return voxels;
     }
 
+    inline void RawFileStructuredVolume::generateVKLVolume()
+    {
+      volume = vklNewVolume(gridType.c_str());
+
+      vklSetVec3i(
+          volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+      vklSetVec3f(
+          volume, "gridOrigin", gridOrigin.x, gridOrigin.y, gridOrigin.z);
+      vklSetVec3f(
+          volume, "gridSpacing", gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+      VKLData data = vklNewDataFromFile(
+          filename.c_str(), 0, dimensions.long_product(), voxelType);
+
+      if (!data) {
+        throw std::runtime_error("error mapping raw volume file");
+      }
+
+      vklSetData(volume, "data", data);
+      vklRelease(data);
+
+      vklCommit(volume);
+
+      // computing the value range here would read the entire file; use the
+      // value range computed by Open VKL instead
+      const vkl_range1f valueRange = vklGetValueRange(volume);
+      computedValueRange = range1f(valueRange.lower, valueRange.upper);
+    }
+
   }  // namespace testing
 }  // namespace openvkl
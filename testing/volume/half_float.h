@@ -0,0 +1,32 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace openvkl {
+  namespace testing {
+
+    // converts a float to half precision (IEEE 754 binary16). only valid for
+    // zero and values which are exactly representable as normalized half
+    // values.
+    inline uint16_t floatToHalf(float f)
+    {
+      uint32_t bits;
+      std::memcpy(&bits, &f, sizeof(float));
+
+      const uint32_t sign     = (bits >> 16) & 0x8000;
+      const uint32_t exponent = ((bits >> 23) & 0xff) - 127 + 15;
+      const uint32_t mantissa = bits & 0x7fffff;
+
+      if ((bits & 0x7fffffff) == 0) {
+        return sign;
+      }
+
+      return sign | (exponent << 10) | (mantissa >> 13);
+    }
+
+  }  // namespace testing
+}  // namespace openvkl
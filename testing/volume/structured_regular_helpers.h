@@ -0,0 +1,82 @@
+// Copyright 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+// openvkl
+#include "openvkl/openvkl.h"
+// ospcommon
+#include "ospcommon/math/vec.h"
+
+namespace openvkl {
+  namespace testing {
+
+    // creates a structured regular volume with the given grid and data, without
+    // committing it. data may be null, e.g. for volumes given timestep data
+    // instead. this is meant for tests which need control over the data
+    // objects or voxel values; the procedural volumes are preferable otherwise.
+    inline VKLVolume newStructuredRegularVolume(const vec3i &dimensions,
+                                                const vec3f &gridOrigin,
+                                                const vec3f &gridSpacing,
+                                                VKLData data)
+    {
+      VKLVolume volume = vklNewVolume("structuredRegular");
+
+      vklSetVec3i(
+          volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+      vklSetVec3f(
+          volume, "gridOrigin", gridOrigin.x, gridOrigin.y, gridOrigin.z);
+      vklSetVec3f(
+          volume, "gridSpacing", gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+      if (data) {
+        vklSetData(volume, "data", data);
+      }
+
+      return volume;
+    }
+
+    // as above, with data created from the given voxels in x-fastest order
+    inline VKLVolume newStructuredRegularVolume(
+        const vec3i &dimensions,
+        const vec3f &gridOrigin,
+        const vec3f &gridSpacing,
+        VKLDataType voxelType,
+        const void *voxels,
+        VKLDataCreationFlags dataCreationFlags = VKL_DATA_DEFAULT)
+    {
+      VKLData data = vklNewData(
+          dimensions.long_product(), voxelType, voxels, dataCreationFlags);
+
+      VKLVolume volume =
+          newStructuredRegularVolume(dimensions, gridOrigin, gridSpacing, data);
+      vklRelease(data);
+
+      return volume;
+    }
+
+    // voxels of a smooth field without symmetries, in x-fastest order. the
+    // phase shifts the field along x, giving distinct volumes of the same
+    // dimensions.
+    inline std::vector<float> generateSmoothVoxels(const vec3i &dimensions,
+                                                   float phase = 0.f)
+    {
+      std::vector<float> voxels;
+      voxels.reserve(dimensions.long_product());
+
+      for (int z = 0; z < dimensions.z; z++) {
+        for (int y = 0; y < dimensions.y; y++) {
+          for (int x = 0; x < dimensions.x; x++) {
+            voxels.push_back(std::sin(0.1f * x + phase) +
+                             std::cos(0.2f * y) + 0.01f * z);
+          }
+        }
+      }
+
+      return voxels;
+    }
+
+  }  // namespace testing
+}  // namespace openvkl